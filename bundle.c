@@ -0,0 +1,408 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "bundle.h"
+
+/** layout of a bundle file (little endian) :
+ * - header : "MARCBDL1", version (u32), number of sections (u32), x_max (u32), y_max (u32), soil costs (5 x i32)
+ * - table of contents : one t_bundle_entry per section, right after the header
+ * - the sections, each aligned on a page so that the sections not used are never read
+ */
+#define BUNDLE_MAGIC "MARCBDL1"
+#define BUNDLE_VERSION 1
+#define BUNDLE_HEADER_SIZE 64
+#define BUNDLE_ALIGN 4096
+
+/**
+ * @brief Structure for a bundle being written
+ */
+typedef struct s_bundle_writer
+{
+    FILE            *file;
+    char            *filename;
+    uint64_t        end;
+    t_bundle_entry  entries[NB_BUNDLE_SECTIONS];
+    int             nbSections;
+} t_bundle_writer;
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to write a buffer at the end of a bundle being written, exiting on error
+ * @param p_writer : pointer to the writer
+ * @param buffer : the buffer
+ * @param size : the size of the buffer
+ * @return none
+ */
+void writeBundleBytes(t_bundle_writer *, const void *, size_t);
+
+/**
+ * @brief function to pad a bundle being written with zeros up to the next page
+ * @param p_writer : pointer to the writer
+ * @return none
+ */
+void padBundle(t_bundle_writer *);
+
+/**
+ * @brief function to start a section of a bundle being written
+ * @param p_writer : pointer to the writer
+ * @param section : the section
+ * @param extra : the extra value of its entry
+ * @return none
+ */
+void beginBundleSection(t_bundle_writer *, t_bundle_section, uint32_t);
+
+/**
+ * @brief function to end the section of a bundle being written, its size is the bytes written since it began
+ * @param p_writer : pointer to the writer
+ * @return none
+ */
+void endBundleSection(t_bundle_writer *);
+
+/**
+ * @brief function to get a section that a structure of a bundle needs, exiting if it is missing or too small
+ * @param p_bundle : pointer to the bundle
+ * @param section : the section
+ * @param size : the smallest size of the section
+ * @return pointer to the section
+ */
+char *requireBundleSection(t_bundle *, t_bundle_section, size_t);
+
+/**
+ * @brief function to build the map of a bundle if it is not yet, the lock of the bundle must be held
+ * @param p_bundle : pointer to the bundle
+ * @return none
+ */
+void buildBundleMap(t_bundle *);
+
+/* definition of local functions */
+
+void writeBundleBytes(t_bundle_writer *p_writer, const void *buffer, size_t size)
+{
+    if (size > 0 && fwrite(buffer, size, 1, p_writer->file) != 1)
+    {
+        fprintf(stderr, "Error: cannot write file %s\n", p_writer->filename);
+        exit(1);
+    }
+    p_writer->end += size;
+    return;
+}
+
+void padBundle(t_bundle_writer *p_writer)
+{
+    static const char zeros[BUNDLE_ALIGN] = {0};
+    writeBundleBytes(p_writer, zeros, (BUNDLE_ALIGN - p_writer->end % BUNDLE_ALIGN) % BUNDLE_ALIGN);
+    return;
+}
+
+void beginBundleSection(t_bundle_writer *p_writer, t_bundle_section section, uint32_t extra)
+{
+    padBundle(p_writer);
+    t_bundle_entry *p_entry = &p_writer->entries[p_writer->nbSections];
+    p_entry->section = (uint32_t)section;
+    p_entry->extra = extra;
+    p_entry->offset = p_writer->end;
+    p_entry->size = 0;
+    return;
+}
+
+void endBundleSection(t_bundle_writer *p_writer)
+{
+    t_bundle_entry *p_entry = &p_writer->entries[p_writer->nbSections++];
+    p_entry->size = p_writer->end - p_entry->offset;
+    return;
+}
+
+char *requireBundleSection(t_bundle *p_bundle, t_bundle_section section, size_t size)
+{
+    static const char *names[NB_BUNDLE_SECTIONS] = {"soils", "costs", "reach", "tree", "plane"};
+    size_t found;
+    char *data = (char *)getBundleSection(p_bundle, section, &found);
+    if (data == NULL || found < size)
+    {
+        fprintf(stderr, "Error: the bundle has no complete %s section\n", names[section]);
+        exit(1);
+    }
+    return data;
+}
+
+void buildBundleMap(t_bundle *p_bundle)
+{
+    if (p_bundle->built[BUNDLE_SOILS])
+    {
+        return;
+    }
+    t_map *p_map = &p_bundle->map;
+    size_t nbCells = (size_t)p_map->x_max * p_map->y_max;
+    t_soil *soils = (t_soil *)requireBundleSection(p_bundle, BUNDLE_SOILS, nbCells * sizeof(t_soil));
+    int *costs = (int *)requireBundleSection(p_bundle, BUNDLE_COSTS, nbCells * sizeof(int));
+    p_map->soils = (t_soil **)malloc(p_map->y_max * sizeof(t_soil *));
+    p_map->costs = (int **)malloc(p_map->y_max * sizeof(int *));
+    for (int i = 0; i < p_map->y_max; i++)
+    {
+        p_map->soils[i] = soils + (size_t)i * p_map->x_max;
+        p_map->costs[i] = costs + (size_t)i * p_map->x_max;
+    }
+    p_bundle->built[BUNDLE_SOILS] = 1;
+    return;
+}
+
+/* definitions of exported functions */
+
+void writeBundle(char *filename, t_map map, int max_reach)
+{
+    t_bundle_writer writer;
+    writer.file = fopen(filename, "wb");
+    if (writer.file == NULL)
+    {
+        fprintf(stderr, "Error: cannot open file %s\n", filename);
+        exit(1);
+    }
+    writer.filename = filename;
+    writer.end = 0;
+    writer.nbSections = 0;
+    // the header and the table of contents are written again at the end, once the sections are known
+    char header[BUNDLE_HEADER_SIZE + NB_BUNDLE_SECTIONS * sizeof(t_bundle_entry)] = {0};
+    writeBundleBytes(&writer, header, sizeof(header));
+
+    beginBundleSection(&writer, BUNDLE_SOILS, 0);
+    for (int i = 0; i < map.y_max; i++)
+    {
+        writeBundleBytes(&writer, map.soils[i], map.x_max * sizeof(t_soil));
+    }
+    endBundleSection(&writer);
+    beginBundleSection(&writer, BUNDLE_COSTS, 0);
+    for (int i = 0; i < map.y_max; i++)
+    {
+        writeBundleBytes(&writer, map.costs[i], map.x_max * sizeof(int));
+    }
+    endBundleSection(&writer);
+
+    size_t nbCells = (size_t)map.x_max * map.y_max;
+    t_planner planner = createPlanner(map, max_reach);
+    // the bound of radius 0 is the costs, already in the bundle
+    beginBundleSection(&writer, BUNDLE_REACH, (uint32_t)max_reach);
+    for (int r = 1; r <= max_reach; r++)
+    {
+        writeBundleBytes(&writer, planner.reach_min[r], nbCells * sizeof(int));
+    }
+    endBundleSection(&writer);
+    freePlanner(&planner);
+
+    t_cost_tree tree = createCostTree(map);
+    beginBundleSection(&writer, BUNDLE_TREE, (uint32_t)tree.nbReachable);
+    writeBundleBytes(&writer, tree.costs, nbCells * sizeof(int));
+    writeBundleBytes(&writer, tree.parent, nbCells * sizeof(int));
+    writeBundleBytes(&writer, tree.subtree, nbCells * sizeof(int));
+    writeBundleBytes(&writer, tree.first, nbCells * sizeof(int));
+    writeBundleBytes(&writer, tree.preorder, nbCells * sizeof(int));
+    endBundleSection(&writer);
+    freeCostTree(&tree);
+
+    t_cost_plane plane = createCostPlane(map);
+    int nbBlocks = plane.blocks_x * plane.blocks_y;
+    beginBundleSection(&writer, BUNDLE_PLANE, 0);
+    writeBundleBytes(&writer, plane.bases, nbBlocks * sizeof(int32_t));
+    writeBundleBytes(&writer, plane.offsets, (nbBlocks + 1) * sizeof(uint32_t));
+    writeBundleBytes(&writer, plane.deltas, plane.offsets[nbBlocks] + 1);
+    endBundleSection(&writer);
+    freeCostPlane(&plane);
+    padBundle(&writer);
+
+    uint32_t version = BUNDLE_VERSION;
+    uint32_t nbSections = (uint32_t)writer.nbSections;
+    uint32_t x_max = (uint32_t)map.x_max;
+    uint32_t y_max = (uint32_t)map.y_max;
+    memcpy(header, BUNDLE_MAGIC, 8);
+    memcpy(header + 8, &version, 4);
+    memcpy(header + 12, &nbSections, 4);
+    memcpy(header + 16, &x_max, 4);
+    memcpy(header + 20, &y_max, 4);
+    memcpy(header + 24, map.soil_costs->cost, (CREVASSE + 1) * sizeof(int));
+    memcpy(header + BUNDLE_HEADER_SIZE, writer.entries, writer.nbSections * sizeof(t_bundle_entry));
+    if (fseek(writer.file, 0, SEEK_SET) != 0 || fwrite(header, sizeof(header), 1, writer.file) != 1
+        || fclose(writer.file) != 0)
+    {
+        fprintf(stderr, "Error: cannot write file %s\n", filename);
+        exit(1);
+    }
+    return;
+}
+
+t_bundle *openBundle(char *filename)
+{
+    int fd = open(filename, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0)
+    {
+        fprintf(stderr, "Error: cannot open file %s\n", filename);
+        exit(1);
+    }
+    size_t size = (size_t)st.st_size;
+    if (size < BUNDLE_HEADER_SIZE)
+    {
+        fprintf(stderr, "Error: %s is not a bundle file\n", filename);
+        exit(1);
+    }
+    char *data = (char *)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        fprintf(stderr, "Error: cannot map file %s\n", filename);
+        exit(1);
+    }
+    uint32_t nbSections, x_max, y_max;
+    int costs[CREVASSE + 1];
+    memcpy(&nbSections, data + 12, 4);
+    memcpy(&x_max, data + 16, 4);
+    memcpy(&y_max, data + 20, 4);
+    memcpy(costs, data + 24, sizeof(costs));
+    if (memcmp(data, BUNDLE_MAGIC, 8) != 0 || nbSections > NB_BUNDLE_SECTIONS || x_max == 0 || y_max == 0
+        || BUNDLE_HEADER_SIZE + nbSections * sizeof(t_bundle_entry) > size)
+    {
+        fprintf(stderr, "Error: %s is not a complete bundle file\n", filename);
+        exit(1);
+    }
+
+    t_bundle *p_bundle = (t_bundle *)calloc(1, sizeof(t_bundle));
+    p_bundle->data = data;
+    p_bundle->size = size;
+    const t_bundle_entry *entries = (const t_bundle_entry *)(data + BUNDLE_HEADER_SIZE);
+    for (uint32_t e = 0; e < nbSections; e++)
+    {
+        if (entries[e].section >= NB_BUNDLE_SECTIONS || entries[e].offset % BUNDLE_ALIGN != 0
+            || entries[e].offset > size || entries[e].size > size - entries[e].offset)
+        {
+            fprintf(stderr, "Error: %s is not a complete bundle file\n", filename);
+            exit(1);
+        }
+        p_bundle->entries[entries[e].section] = &entries[e];
+    }
+    p_bundle->soil_costs = createSoilCosts(costs);
+    p_bundle->map.x_max = (int)x_max;
+    p_bundle->map.y_max = (int)y_max;
+    p_bundle->map.soil_costs = &p_bundle->soil_costs;
+    p_bundle->map.summary.nbBases = -1;
+    pthread_mutex_init(&p_bundle->lock, NULL);
+    return p_bundle;
+}
+
+void closeBundle(t_bundle *p_bundle)
+{
+    // only the arrays of pointers were allocated, the structures point into the mapping
+    if (p_bundle->built[BUNDLE_SOILS])
+    {
+        free(p_bundle->map.soils);
+        free(p_bundle->map.costs);
+    }
+    if (p_bundle->built[BUNDLE_REACH])
+    {
+        free(p_bundle->planner.reach_min);
+    }
+    pthread_mutex_destroy(&p_bundle->lock);
+    munmap(p_bundle->data, p_bundle->size);
+    free(p_bundle);
+    return;
+}
+
+const void *getBundleSection(t_bundle *p_bundle, t_bundle_section section, size_t *p_size)
+{
+    const t_bundle_entry *p_entry = p_bundle->entries[section];
+    if (p_entry == NULL)
+    {
+        return NULL;
+    }
+    if (p_size != NULL)
+    {
+        *p_size = (size_t)p_entry->size;
+    }
+    madvise(p_bundle->data + p_entry->offset, (size_t)p_entry->size, MADV_WILLNEED);
+    return p_bundle->data + p_entry->offset;
+}
+
+const t_map *getBundleMap(t_bundle *p_bundle)
+{
+    pthread_mutex_lock(&p_bundle->lock);
+    buildBundleMap(p_bundle);
+    pthread_mutex_unlock(&p_bundle->lock);
+    return &p_bundle->map;
+}
+
+const t_planner *getBundlePlanner(t_bundle *p_bundle)
+{
+    pthread_mutex_lock(&p_bundle->lock);
+    if (!p_bundle->built[BUNDLE_REACH])
+    {
+        buildBundleMap(p_bundle);
+        int max_reach = (p_bundle->entries[BUNDLE_REACH] != NULL) ? (int)p_bundle->entries[BUNDLE_REACH]->extra : 0;
+        size_t nbCells = (size_t)p_bundle->map.x_max * p_bundle->map.y_max;
+        int *reach = (int *)requireBundleSection(p_bundle, BUNDLE_REACH, max_reach * nbCells * sizeof(int));
+        t_planner *p_planner = &p_bundle->planner;
+        p_planner->map = p_bundle->map;
+        p_planner->max_reach = max_reach;
+        p_planner->reach_min = (int **)malloc((max_reach + 1) * sizeof(int *));
+        p_planner->reach_min[0] = p_bundle->map.costs[0];
+        for (int r = 1; r <= max_reach; r++)
+        {
+            p_planner->reach_min[r] = reach + (r - 1) * nbCells;
+        }
+        p_bundle->built[BUNDLE_REACH] = 1;
+    }
+    pthread_mutex_unlock(&p_bundle->lock);
+    return &p_bundle->planner;
+}
+
+const t_cost_tree *getBundleCostTree(t_bundle *p_bundle)
+{
+    pthread_mutex_lock(&p_bundle->lock);
+    if (!p_bundle->built[BUNDLE_TREE])
+    {
+        buildBundleMap(p_bundle);
+        size_t nbCells = (size_t)p_bundle->map.x_max * p_bundle->map.y_max;
+        int *arrays = (int *)requireBundleSection(p_bundle, BUNDLE_TREE, 5 * nbCells * sizeof(int));
+        t_cost_tree *p_tree = &p_bundle->tree;
+        p_tree->map = p_bundle->map;
+        p_tree->costs = arrays;
+        p_tree->parent = arrays + nbCells;
+        p_tree->subtree = arrays + 2 * nbCells;
+        p_tree->first = arrays + 3 * nbCells;
+        p_tree->preorder = arrays + 4 * nbCells;
+        p_tree->nbReachable = (int)p_bundle->entries[BUNDLE_TREE]->extra;
+        p_bundle->built[BUNDLE_TREE] = 1;
+    }
+    pthread_mutex_unlock(&p_bundle->lock);
+    return &p_bundle->tree;
+}
+
+const t_cost_plane *getBundleCostPlane(t_bundle *p_bundle)
+{
+    pthread_mutex_lock(&p_bundle->lock);
+    if (!p_bundle->built[BUNDLE_PLANE])
+    {
+        t_cost_plane *p_plane = &p_bundle->plane;
+        p_plane->x_max = p_bundle->map.x_max;
+        p_plane->y_max = p_bundle->map.y_max;
+        p_plane->blocks_x = (p_plane->x_max + COST_BLOCK_SIDE - 1) / COST_BLOCK_SIDE;
+        p_plane->blocks_y = (p_plane->y_max + COST_BLOCK_SIDE - 1) / COST_BLOCK_SIDE;
+        size_t nbBlocks = (size_t)p_plane->blocks_x * p_plane->blocks_y;
+        size_t header = nbBlocks * sizeof(int32_t) + (nbBlocks + 1) * sizeof(uint32_t);
+        char *data = requireBundleSection(p_bundle, BUNDLE_PLANE, header);
+        p_plane->bases = (int32_t *)data;
+        p_plane->offsets = (uint32_t *)(data + nbBlocks * sizeof(int32_t));
+        // the deltas end with a byte of padding, as in createCostPlane
+        requireBundleSection(p_bundle, BUNDLE_PLANE, header + p_plane->offsets[nbBlocks] + 1);
+        p_plane->deltas = (uint8_t *)(data + header);
+        p_bundle->built[BUNDLE_PLANE] = 1;
+    }
+    pthread_mutex_unlock(&p_bundle->lock);
+    return &p_bundle->plane;
+}
@@ -0,0 +1,120 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_BUNDLE_H
+#define UNTITLED1_BUNDLE_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "costplane.h"
+#include "critical.h"
+#include "map.h"
+#include "planner.h"
+
+/**
+ * @brief Enum for the sections of a bundle
+ */
+typedef enum e_bundle_section
+{
+    BUNDLE_SOILS,   // soils, row by row
+    BUNDLE_COSTS,   // costs, row by row (also the bound of radius 0 of the planner)
+    BUNDLE_REACH,   // bounds of radius 1 to max_reach of the planner, one plane per radius
+    BUNDLE_TREE,    // costs, parent, subtree, first and preorder of the shortest-path tree
+    BUNDLE_PLANE,   // bases, offsets and deltas of the cost plane
+    NB_BUNDLE_SECTIONS
+} t_bundle_section;
+
+/**
+ * @brief Structure for an entry of the table of contents of a bundle
+ */
+typedef struct s_bundle_entry
+{
+    uint32_t    section;
+    uint32_t    extra;  // max_reach for BUNDLE_REACH, the number of reachable cells for BUNDLE_TREE
+    uint64_t    offset; // aligned on a page
+    uint64_t    size;
+} t_bundle_entry;
+
+/**
+ * @brief Structure for a bundle mapped in memory : a map and its derived structures, built once
+ * the pages of a section are only read when one of its structures is first asked for; the structures point
+ * into the mapping and belong to the bundle
+ */
+typedef struct s_bundle
+{
+    char                    *data;
+    size_t                  size;
+    const t_bundle_entry    *entries[NB_BUNDLE_SECTIONS];   // NULL for a section the bundle does not have
+    t_soil_costs            soil_costs;
+    t_map                   map;        // soils and costs, built on first use
+    t_planner               planner;    // built on first use
+    t_cost_tree             tree;       // built on first use
+    t_cost_plane            plane;      // built on first use
+    int                     built[NB_BUNDLE_SECTIONS];  // 1 once the structure read from a section is built
+                                                        // (the map for BUNDLE_SOILS, the planner for BUNDLE_REACH)
+    pthread_mutex_t         lock;       // taken while a structure is built
+} t_bundle;
+
+/**
+ * @brief Function to build the derived structures of a map and write them in a bundle file
+ * @param filename : the name of the file
+ * @param map : the map, with its costs computed
+ * @param max_reach : the largest translation the planner is built for (see createPlanner)
+ * @return none
+ */
+void writeBundle(char *, t_map, int);
+
+/**
+ * @brief Function to map a bundle in memory (pages are private : writing to a structure does not change the file)
+ * @param filename : the name of the file
+ * @return pointer to the bundle
+ */
+t_bundle *openBundle(char *);
+
+/**
+ * @brief Function to unmap a bundle and free it, its structures must not be used any more
+ * @param p_bundle : pointer to the bundle
+ * @return none
+ */
+void closeBundle(t_bundle *);
+
+/**
+ * @brief Function to get the bytes of a section of a bundle, advising the kernel to read them ahead
+ * @param p_bundle : pointer to the bundle
+ * @param section : the section
+ * @param p_size : pointer receiving the size of the section (can be NULL)
+ * @return pointer to the section, NULL if the bundle does not have it
+ */
+const void *getBundleSection(t_bundle *, t_bundle_section, size_t *);
+
+/**
+ * @brief Function to get the map of a bundle (soils and costs)
+ * @param p_bundle : pointer to the bundle
+ * @return pointer to the map
+ */
+const t_map *getBundleMap(t_bundle *);
+
+/**
+ * @brief Function to get the planner of a bundle
+ * @param p_bundle : pointer to the bundle
+ * @return pointer to the planner
+ */
+const t_planner *getBundlePlanner(t_bundle *);
+
+/**
+ * @brief Function to get the shortest-path tree of a bundle
+ * @param p_bundle : pointer to the bundle
+ * @return pointer to the tree
+ */
+const t_cost_tree *getBundleCostTree(t_bundle *);
+
+/**
+ * @brief Function to get the cost plane of a bundle
+ * @param p_bundle : pointer to the bundle
+ * @return pointer to the cost plane
+ */
+const t_cost_plane *getBundleCostPlane(t_bundle *);
+
+#endif //UNTITLED1_BUNDLE_H
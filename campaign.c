@@ -0,0 +1,120 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "mission.h"
+#include "speculate.h"
+
+/**
+ * @brief Number of entries of the cache of the speculative planner of a real-time campaign
+ */
+#define CAMPAIGN_SPEC_CAPACITY 256
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to run the missions of a seed range in the real-time mode and print the latency of the phases
+ * @param p_planner : pointer to the planner of the map
+ * @param seed_begin : the first seed
+ * @param seed_end : the seed after the last one
+ * @param nbWorkers : the number of workers of the speculative planner, 0 to plan each phase with planBest
+ * @return the summary of the missions
+ */
+t_campaign_summary runRealTimeCampaign(t_planner *, uint64_t, uint64_t, int);
+
+/* definition of local functions */
+
+t_campaign_summary runRealTimeCampaign(t_planner *p_planner, uint64_t seed_begin, uint64_t seed_end, int nbWorkers)
+{
+    t_mission_config config = createMissionConfig(p_planner, 9, 5, MISSION_MAX_PHASES);
+    t_pool *p_pool = NULL;
+    t_speculator *p_spec = NULL;
+    if (nbWorkers > 0)
+    {
+        // everything the phases use is created and sized before the memory is locked
+        p_pool = createPool(nbWorkers, 0);
+        p_spec = createSpeculator(p_planner, config.nbDraw, config.nbChoose, p_pool, CAMPAIGN_SPEC_CAPACITY);
+        reservePoolQueues(p_pool, CAMPAIGN_SPEC_CAPACITY);
+        config.strategy = speculativeStrategy;
+        config.ctx = p_spec;
+        config.phaseEnd = speculateNextPhase;
+    }
+    uint64_t nbMissions = seed_end - seed_begin;
+    t_rt rt = rtInit(nbMissions * sizeof(t_mission_record) + 4096);
+    config.rt = &rt;
+    // the records are kept in the arena, which is locked and prefaulted
+    t_mission_record *records = (t_mission_record *)arenaAlloc(&rt.arena, nbMissions * sizeof(t_mission_record));
+    t_campaign_summary summary = createCampaignSummary(seed_begin, seed_end);
+    for (uint64_t i = 0; i < nbMissions; i++)
+    {
+        records[i] = simulateMission(&config, seed_begin + i);
+        addToCampaignSummary(&summary, &records[i]);
+    }
+    rtReport(rt, stdout);
+    if (p_spec != NULL)
+    {
+        printf("Speculation : %ld hits, %ld misses, %ld cancelled\n", p_spec->hits, p_spec->misses, p_spec->cancelled);
+        freeSpeculator(p_spec);
+        freePool(p_pool);
+    }
+    rtRelease(&rt);
+    return summary;
+}
+
+/**
+ * campaign <map file> <first seed> <end seed> <shards> <prefix>
+ * runs the missions of the seeds [first seed, end seed) in <shards> processes and prints their summary
+ * campaign -r <map file> <first seed> <end seed> [workers]
+ * runs them in this process in the real-time mode, planned speculatively by [workers] workers if given,
+ * and prints the worst latency of the phases too
+ */
+int main(int argc, char **argv)
+{
+    int realtime = (argc > 1 && strcmp(argv[1], "-r") == 0);
+    if ((!realtime && argc != 6) || (realtime && argc != 5 && argc != 6))
+    {
+        fprintf(stderr, "Usage: %s <map file> <first seed> <end seed> <shards> <prefix>\n"
+                        "       %s -r <map file> <first seed> <end seed> [workers]\n", argv[0], argv[0]);
+        return 1;
+    }
+    char **args = argv + realtime;
+    uint64_t seed_begin = strtoull(args[2], NULL, 10);
+    uint64_t seed_end = strtoull(args[3], NULL, 10);
+    int nbShards = (!realtime) ? atoi(args[4]) : 1;
+    int nbWorkers = (realtime && argc == 6) ? atoi(args[4]) : 0;
+    if (seed_end < seed_begin || nbShards < 1 || nbWorkers < 0)
+    {
+        fprintf(stderr, "Error: invalid seed range, number of shards or number of workers\n");
+        return 1;
+    }
+
+    t_map map = createMapFromFile(args[1]);
+    t_planner planner = createPlanner(map, 15);
+    t_campaign_summary summary;
+    if (realtime)
+    {
+        summary = runRealTimeCampaign(&planner, seed_begin, seed_end, nbWorkers);
+    }
+    else
+    {
+        t_mission_config config = createMissionConfig(&planner, 9, 5, MISSION_MAX_PHASES);
+        summary = runShardedCampaign(&config, seed_begin, seed_end, nbShards, args[5]);
+    }
+
+    printf("Missions : %llu (seeds %llu to %llu)\n", (unsigned long long)summary.nbMissions,
+           (unsigned long long)summary.seed_begin, (unsigned long long)summary.seed_end);
+    printf("Base reached : %llu\n", (unsigned long long)summary.nbOutcomes[OUTCOME_BASE]);
+    printf("Crevasse : %llu\n", (unsigned long long)summary.nbOutcomes[OUTCOME_CREVASSE]);
+    printf("Out of the map : %llu\n", (unsigned long long)summary.nbOutcomes[OUTCOME_OUT]);
+    printf("Timeout : %llu\n", (unsigned long long)summary.nbOutcomes[OUTCOME_TIMEOUT]);
+    if (summary.nbMissions > 0)
+    {
+        printf("Mean phases : %.3f\n", (double)summary.totalPhases / summary.nbMissions);
+    }
+    freePlanner(&planner);
+    return 0;
+}
@@ -0,0 +1,289 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "coalesce.h"
+
+#define COALESCE_DEFAULT_SHARDS 16
+#define COALESCE_SHARD_BUCKETS 16
+
+/**
+ * @brief Kind of the keys of coalescedPlanBest
+ */
+#define COALESCE_KIND_PLAN 1
+
+_Static_assert(sizeof(t_coalesce_key) == 48, "the keys of a coalescer have no implicit padding");
+
+/**
+ * @brief Structure for the context of a coalesced planBest
+ */
+typedef struct s_coalesced_search
+{
+    const t_planner *planner;
+    t_localisation  loc;
+    const t_move    *draw;
+    int             nbDraw;
+    int             nbChoose;
+} t_coalesced_search;
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to hash the bytes of a key (FNV-1a, then mixed so that the low bits select shards and buckets)
+ * @param p_key : pointer to the key
+ * @return the hash
+ */
+uint64_t hashCoalesceKey(const t_coalesce_key *);
+
+/**
+ * @brief function to read the monotonic clock
+ * @return the time in ns
+ */
+uint64_t getCoalesceClock(void);
+
+/**
+ * @brief function to drop a reference to a computation whose result is published, freeing it with the last one
+ * the lock of its shard must be held
+ * @param p_inflight : pointer to the computation
+ * @return none
+ */
+void releaseInflight(t_inflight *);
+
+/**
+ * @brief function to run planBest for a coalesced request (see t_coalesced_fn)
+ * @param ctx : pointer to the t_coalesced_search
+ * @param result : the t_plan receiving the plan
+ * @return the result of planBest
+ */
+int runCoalescedSearch(void *, void *);
+
+/* definition of local functions */
+
+uint64_t hashCoalesceKey(const t_coalesce_key *p_key)
+{
+    const unsigned char *bytes = (const unsigned char *)p_key;
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < sizeof(t_coalesce_key); i++)
+    {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+uint64_t getCoalesceClock(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+void releaseInflight(t_inflight *p_inflight)
+{
+    assert(p_inflight->done && p_inflight->refs > 0);
+    if (--p_inflight->refs == 0)
+    {
+        pthread_cond_destroy(&p_inflight->finished);
+        free(p_inflight);
+    }
+    return;
+}
+
+int runCoalescedSearch(void *ctx, void *result)
+{
+    t_coalesced_search *p_search = (t_coalesced_search *)ctx;
+    return planBest(p_search->planner, p_search->loc, p_search->draw, p_search->nbDraw, p_search->nbChoose,
+                    (t_plan *)result);
+}
+
+/* definitions of exported functions */
+
+t_coalescer *createCoalescer(int nbShards)
+{
+    int n = 1;
+    while (n < ((nbShards > 0) ? nbShards : COALESCE_DEFAULT_SHARDS))
+    {
+        n *= 2;
+    }
+    t_coalescer *p_coalescer = (t_coalescer *)malloc(sizeof(t_coalescer));
+    p_coalescer->nbShards = n;
+    p_coalescer->shards = (t_coalesce_shard *)malloc(n * sizeof(t_coalesce_shard));
+    for (int s = 0; s < n; s++)
+    {
+        pthread_mutex_init(&p_coalescer->shards[s].lock, NULL);
+        p_coalescer->shards[s].nbBuckets = COALESCE_SHARD_BUCKETS;
+        p_coalescer->shards[s].buckets = (t_inflight **)calloc(COALESCE_SHARD_BUCKETS, sizeof(t_inflight *));
+    }
+    atomic_init(&p_coalescer->nbRequests, 0);
+    atomic_init(&p_coalescer->nbComputed, 0);
+    atomic_init(&p_coalescer->nbCoalesced, 0);
+    atomic_init(&p_coalescer->computed_ns, 0);
+    atomic_init(&p_coalescer->saved_ns, 0);
+    atomic_init(&p_coalescer->waited_ns, 0);
+    return p_coalescer;
+}
+
+void freeCoalescer(t_coalescer *p_coalescer)
+{
+    for (int s = 0; s < p_coalescer->nbShards; s++)
+    {
+        for (int b = 0; b < p_coalescer->shards[s].nbBuckets; b++)
+        {
+            assert(p_coalescer->shards[s].buckets[b] == NULL);
+        }
+        pthread_mutex_destroy(&p_coalescer->shards[s].lock);
+        free(p_coalescer->shards[s].buckets);
+    }
+    free(p_coalescer->shards);
+    free(p_coalescer);
+    return;
+}
+
+t_coalesce_key createCoalesceKey(const void *source, uint64_t version, int kind)
+{
+    t_coalesce_key key;
+    memset(&key, 0, sizeof(t_coalesce_key));
+    key.source = source;
+    key.version = version;
+    key.kind = kind;
+    return key;
+}
+
+int runCoalesced(t_coalescer *p_coalescer, const t_coalesce_key *p_key, t_coalesced_fn fn, void *ctx, void *result,
+                 size_t size)
+{
+    assert(size <= COALESCE_MAX_RESULT);
+    atomic_fetch_add_explicit(&p_coalescer->nbRequests, 1, memory_order_relaxed);
+    uint64_t hash = hashCoalesceKey(p_key);
+    t_coalesce_shard *p_shard = &p_coalescer->shards[hash & (p_coalescer->nbShards - 1)];
+    t_inflight **p_bucket = &p_shard->buckets[(hash >> 32) & (p_shard->nbBuckets - 1)];
+
+    pthread_mutex_lock(&p_shard->lock);
+    t_inflight *p_inflight = *p_bucket;
+    while (p_inflight != NULL && (p_inflight->hash != hash || memcmp(&p_inflight->key, p_key, sizeof(t_coalesce_key)) != 0))
+    {
+        p_inflight = p_inflight->next;
+    }
+    if (p_inflight != NULL)
+    {
+        // an identical request is being computed : wait for its result
+        uint64_t begin = getCoalesceClock();
+        p_inflight->refs++;
+        while (!p_inflight->done)
+        {
+            pthread_cond_wait(&p_inflight->finished, &p_shard->lock);
+        }
+        int status = p_inflight->status;
+        memcpy(result, p_inflight->result, size);
+        releaseInflight(p_inflight);
+        pthread_mutex_unlock(&p_shard->lock);
+        atomic_fetch_add_explicit(&p_coalescer->nbCoalesced, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&p_coalescer->waited_ns, getCoalesceClock() - begin, memory_order_relaxed);
+        return status;
+    }
+    p_inflight = (t_inflight *)malloc(sizeof(t_inflight));
+    p_inflight->key = *p_key;
+    p_inflight->hash = hash;
+    p_inflight->done = 0;
+    p_inflight->refs = 1;
+    pthread_cond_init(&p_inflight->finished, NULL);
+    p_inflight->next = *p_bucket;
+    *p_bucket = p_inflight;
+    pthread_mutex_unlock(&p_shard->lock);
+
+    // computed without the lock : other keys of the shard go on meanwhile
+    uint64_t begin = getCoalesceClock();
+    int status = fn(ctx, result);
+    uint64_t elapsed = getCoalesceClock() - begin;
+    atomic_fetch_add_explicit(&p_coalescer->nbComputed, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&p_coalescer->computed_ns, elapsed, memory_order_relaxed);
+
+    pthread_mutex_lock(&p_shard->lock);
+    // unlinked before it is published : later requests compute again, the result is not cached
+    t_inflight **p_link = p_bucket;
+    while (*p_link != p_inflight)
+    {
+        p_link = &(*p_link)->next;
+    }
+    *p_link = p_inflight->next;
+    memcpy(p_inflight->result, result, size);
+    p_inflight->status = status;
+    p_inflight->done = 1;
+    int nbWaiters = p_inflight->refs - 1;
+    if (nbWaiters > 0)
+    {
+        pthread_cond_broadcast(&p_inflight->finished);
+    }
+    releaseInflight(p_inflight);
+    pthread_mutex_unlock(&p_shard->lock);
+    atomic_fetch_add_explicit(&p_coalescer->saved_ns, elapsed * (uint64_t)nbWaiters, memory_order_relaxed);
+    return status;
+}
+
+int coalescedPlanBest(t_coalescer *p_coalescer, const t_planner *p_planner, uint64_t version, t_localisation loc,
+                      const t_move *draw, int nbDraw, int nbChoose, t_plan *p_plan)
+{
+    assert(nbDraw > 0 && nbDraw <= PLAN_MAX_MOVES);
+    t_coalesce_key key = createCoalesceKey(p_planner, version, COALESCE_KIND_PLAN);
+    key.x = loc.pos.x;
+    key.y = loc.pos.y;
+    key.ori = (int32_t)loc.ori;
+    key.nbDraw = (uint8_t)nbDraw;
+    key.nbChoose = (uint8_t)nbChoose;
+    // the draw is sorted (insertion sort, a few moves) : the same moves drawn in another order share the search
+    t_move sorted[PLAN_MAX_MOVES];
+    for (int i = 0; i < nbDraw; i++)
+    {
+        int j = i;
+        while (j > 0 && sorted[j - 1] > draw[i])
+        {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = draw[i];
+    }
+    for (int i = 0; i < nbDraw; i++)
+    {
+        key.draw[i] = (uint8_t)sorted[i];
+    }
+    t_coalesced_search search;
+    search.planner = p_planner;
+    search.loc = loc;
+    search.draw = sorted;
+    search.nbDraw = nbDraw;
+    search.nbChoose = nbChoose;
+    return runCoalesced(p_coalescer, &key, runCoalescedSearch, &search, p_plan, sizeof(t_plan));
+}
+
+int coalescedStrategy(t_map map, t_localisation loc, const t_move *draw, int nbDraw, int nbChoose, t_move *chosen,
+                      void *ctx)
+{
+    (void)map;
+    t_coalesced_planner *p_ctx = (t_coalesced_planner *)ctx;
+    t_plan plan;
+    if (!coalescedPlanBest(p_ctx->coalescer, p_ctx->planner, p_ctx->version, loc, draw, nbDraw, nbChoose, &plan))
+    {
+        return 0;
+    }
+    memcpy(chosen, plan.moves, plan.nbMoves * sizeof(t_move));
+    return plan.nbMoves;
+}
+
+t_coalesce_stats getCoalesceStats(t_coalescer *p_coalescer)
+{
+    t_coalesce_stats stats;
+    stats.nbRequests = atomic_load(&p_coalescer->nbRequests);
+    stats.nbComputed = atomic_load(&p_coalescer->nbComputed);
+    stats.nbCoalesced = atomic_load(&p_coalescer->nbCoalesced);
+    stats.computed_ns = atomic_load(&p_coalescer->computed_ns);
+    stats.saved_ns = atomic_load(&p_coalescer->saved_ns);
+    stats.waited_ns = atomic_load(&p_coalescer->waited_ns);
+    return stats;
+}
@@ -0,0 +1,179 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_COALESCE_H
+#define UNTITLED1_COALESCE_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "planner.h"
+
+/**
+ * @brief Largest result a coalesced computation can share
+ */
+#define COALESCE_MAX_RESULT sizeof(t_plan)
+
+/**
+ * @brief Structure for the key of a request : identical keys must give identical results
+ * keys are compared byte per byte : they are built with createCoalesceKey (all bytes cleared), then filled
+ */
+typedef struct s_coalesce_key
+{
+    const void  *source;    // what is queried, e.g. the planner of a map
+    uint64_t    version;    // version of the source, changed when the source is rebuilt
+    int32_t     kind;
+    int32_t     x;
+    int32_t     y;
+    int32_t     ori;
+    uint8_t     nbDraw;
+    uint8_t     nbChoose;
+    uint8_t     draw[PLAN_MAX_MOVES];
+    uint8_t     padding[5];
+} t_coalesce_key;
+
+/**
+ * @brief Type for a computation that can be coalesced
+ * @param ctx : the context of the computation
+ * @param result : buffer receiving the result
+ * @return the status of the computation, given to every request sharing it
+ */
+typedef int (*t_coalesced_fn)(void *, void *);
+
+/**
+ * @brief Structure for a computation in flight : the requests with the same key wait on its condition
+ */
+typedef struct s_inflight
+{
+    t_coalesce_key      key;
+    uint64_t            hash;
+    int                 done;
+    int                 status;
+    int                 refs;       // the computing request and the waiting ones
+    pthread_cond_t      finished;
+    struct s_inflight   *next;
+    unsigned char       result[COALESCE_MAX_RESULT];
+} t_inflight;
+
+/**
+ * @brief Structure for a shard of the table of computations in flight, with its own lock
+ */
+typedef struct s_coalesce_shard
+{
+    pthread_mutex_t lock;
+    t_inflight      **buckets;
+    int             nbBuckets;  // a power of 2
+} t_coalesce_shard;
+
+/**
+ * @brief Structure for the counters of a coalescer
+ */
+typedef struct s_coalesce_stats
+{
+    uint64_t    nbRequests;
+    uint64_t    nbComputed;     // requests that ran their computation
+    uint64_t    nbCoalesced;    // requests that waited for the computation of an identical one
+    uint64_t    computed_ns;    // time spent in computations
+    uint64_t    saved_ns;       // time of the computations shared, once per waiting request
+    uint64_t    waited_ns;      // time spent waiting by the coalesced requests
+} t_coalesce_stats;
+
+/**
+ * @brief Structure for a coalescer : identical requests issued while one of them is computed wait for its
+ * result instead of computing it again; a result is not kept once its waiters have it (this is not a cache)
+ */
+typedef struct s_coalescer
+{
+    t_coalesce_shard    *shards;
+    int                 nbShards;   // a power of 2
+    atomic_ullong       nbRequests;
+    atomic_ullong       nbComputed;
+    atomic_ullong       nbCoalesced;
+    atomic_ullong       computed_ns;
+    atomic_ullong       saved_ns;
+    atomic_ullong       waited_ns;
+} t_coalescer;
+
+/**
+ * @brief Structure for the context of a coalesced planner strategy (see coalescedStrategy)
+ */
+typedef struct s_coalesced_planner
+{
+    t_coalescer         *coalescer;
+    const t_planner     *planner;
+    uint64_t            version;
+} t_coalesced_planner;
+
+/**
+ * @brief Function to create a coalescer
+ * @param nbShards : the number of shards of the table (rounded up to a power of 2), 0 for a default
+ * @return pointer to the coalescer
+ */
+t_coalescer *createCoalescer(int);
+
+/**
+ * @brief Function to free a coalescer, no request may be in flight
+ * @param p_coalescer : pointer to the coalescer
+ * @return none
+ */
+void freeCoalescer(t_coalescer *);
+
+/**
+ * @brief Function to create a key with all its bytes cleared
+ * @param source : what is queried
+ * @param version : the version of the source
+ * @param kind : the kind of request, chosen by the caller
+ * @return the key
+ */
+t_coalesce_key createCoalesceKey(const void *, uint64_t, int);
+
+/**
+ * @brief Function to run a computation, or to wait for the result of an identical one already running
+ * @param p_coalescer : pointer to the coalescer
+ * @param p_key : pointer to the key of the request
+ * @param fn : the computation
+ * @param ctx : the context of the computation
+ * @param result : buffer receiving the result
+ * @param size : the size of the result, at most COALESCE_MAX_RESULT
+ * @return the status returned by the computation
+ */
+int runCoalesced(t_coalescer *, const t_coalesce_key *, t_coalesced_fn, void *, void *, size_t);
+
+/**
+ * @brief Function to find the best move sequence of a draw, sharing the search with identical requests (see planBest)
+ * requests whose draws have the same moves in any order are identical : the search runs on the sorted draw
+ * @param p_coalescer : pointer to the coalescer
+ * @param p_planner : pointer to the planner
+ * @param version : the version of the map of the planner
+ * @param loc : the localisation of the robot
+ * @param draw : the moves drawn for the phase
+ * @param nbDraw : the number of moves drawn
+ * @param nbChoose : the maximal number of moves to choose
+ * @param p_plan : pointer to the plan receiving the result
+ * @return 1 if a plan was found, 0 if every sequence is fatal
+ */
+int coalescedPlanBest(t_coalescer *, const t_planner *, uint64_t, t_localisation, const t_move *, int, int, t_plan *);
+
+/**
+ * @brief Function to get the strategy of a planner whose searches are coalesced (see t_strategy)
+ * @param map : the map (unused, the planner has it)
+ * @param loc : the localisation of the robot
+ * @param draw : the moves drawn
+ * @param nbDraw : the number of moves drawn
+ * @param nbChoose : the maximal number of moves to choose
+ * @param chosen : array receiving the moves
+ * @param ctx : pointer to the t_coalesced_planner
+ * @return the number of moves chosen
+ */
+int coalescedStrategy(t_map, t_localisation, const t_move *, int, int, t_move *, void *);
+
+/**
+ * @brief Function to read the counters of a coalescer
+ * @param p_coalescer : pointer to the coalescer
+ * @return the counters
+ */
+t_coalesce_stats getCoalesceStats(t_coalescer *);
+
+#endif //UNTITLED1_COALESCE_H
@@ -0,0 +1,174 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "compare.h"
+
+/**
+ * @brief Structure for the context of a strategy whose calls are timed
+ */
+typedef struct s_timed_strategy
+{
+    t_strategy  strategy;
+    void        *ctx;
+    long long   elapsed_ns;
+} t_timed_strategy;
+
+/**
+ * @brief Structure for a batch of seeds played by every strategy, with its own accumulators
+ */
+typedef struct s_comparison_batch
+{
+    const t_mission_config      *config;
+    const t_compared_strategy   *strategies;
+    int                         nbStrategies;
+    uint64_t                    seed_begin;
+    uint64_t                    seed_end;
+    t_running_stats             values[COMPARE_MAX_STRATEGIES][NB_COMPARED_VALUES];
+    t_running_stats             differences[COMPARE_MAX_STRATEGIES][NB_COMPARED_VALUES];
+} t_comparison_batch;
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to call a strategy and add the time spent to its context (see t_strategy)
+ * @param ctx : pointer to the t_timed_strategy
+ * @return the number of moves chosen by the strategy
+ */
+int timedStrategy(t_map, t_localisation, const t_move *, int, int, t_move *, void *);
+
+/**
+ * @brief function to play the seeds of a batch with every strategy (task of the pool)
+ * @param arg : pointer to the batch
+ * @return none
+ */
+void runComparisonBatch(void *);
+
+/* definition of local functions */
+
+int timedStrategy(t_map map, t_localisation loc, const t_move *draw, int nbDraw, int nbChoose, t_move *chosen, void *ctx)
+{
+    t_timed_strategy *p_timed = (t_timed_strategy *)ctx;
+    struct timespec begin, end;
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+    int nb = p_timed->strategy(map, loc, draw, nbDraw, nbChoose, chosen, p_timed->ctx);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    p_timed->elapsed_ns += (end.tv_sec - begin.tv_sec) * 1000000000LL + (end.tv_nsec - begin.tv_nsec);
+    return nb;
+}
+
+void runComparisonBatch(void *arg)
+{
+    t_comparison_batch *p_batch = (t_comparison_batch *)arg;
+    memset(p_batch->values, 0, sizeof(p_batch->values));
+    memset(p_batch->differences, 0, sizeof(p_batch->differences));
+    for (uint64_t seed = p_batch->seed_begin; seed < p_batch->seed_end; seed++)
+    {
+        double values[COMPARE_MAX_STRATEGIES][NB_COMPARED_VALUES];
+        for (int s = 0; s < p_batch->nbStrategies; s++)
+        {
+            // the seed fixes the start and the draws : only the strategy changes
+            t_timed_strategy timed;
+            timed.strategy = p_batch->strategies[s].strategy;
+            timed.ctx = p_batch->strategies[s].ctx;
+            timed.elapsed_ns = 0;
+            t_mission_config config = *p_batch->config;
+            config.strategy = timedStrategy;
+            config.ctx = &timed;
+            // the batches run in parallel : no phase hook nor real-time context of the caller is shared
+            config.phaseEnd = NULL;
+            config.rt = NULL;
+            t_mission_record record = simulateMission(&config, seed);
+            values[s][COMPARED_SUCCESS] = (record.outcome == OUTCOME_BASE);
+            values[s][COMPARED_PHASES] = record.nbPhases;
+            values[s][COMPARED_PLANNING_NS] = (record.nbPhases > 0) ? (double)timed.elapsed_ns / record.nbPhases : 0.0;
+            for (int v = 0; v < NB_COMPARED_VALUES; v++)
+            {
+                addToRunningStats(&p_batch->values[s][v], values[s][v]);
+                if (s > 0)
+                {
+                    addToRunningStats(&p_batch->differences[s][v], values[s][v] - values[0][v]);
+                }
+            }
+        }
+    }
+    return;
+}
+
+/* definitions of exported functions */
+
+t_comparison compareStrategies(const t_mission_config *p_config, const t_compared_strategy *strategies, int nbStrategies,
+                               t_pool *p_pool, uint64_t seed_begin, uint64_t seed_end, int batchSize)
+{
+    assert(nbStrategies > 0 && nbStrategies <= COMPARE_MAX_STRATEGIES);
+    assert(batchSize > 0 && seed_begin <= seed_end);
+    t_comparison comparison;
+    memset(&comparison, 0, sizeof(t_comparison));
+    comparison.nbStrategies = nbStrategies;
+    comparison.nbMissions = seed_end - seed_begin;
+
+    int nbBatches = (int)((seed_end - seed_begin + batchSize - 1) / batchSize);
+    t_comparison_batch *batches = (t_comparison_batch *)malloc(nbBatches * sizeof(t_comparison_batch));
+    t_task_group group;
+    initTaskGroup(&group);
+    for (int b = 0; b < nbBatches; b++)
+    {
+        batches[b].config = p_config;
+        batches[b].strategies = strategies;
+        batches[b].nbStrategies = nbStrategies;
+        batches[b].seed_begin = seed_begin + (uint64_t)b * batchSize;
+        batches[b].seed_end = (b == nbBatches - 1) ? seed_end : batches[b].seed_begin + batchSize;
+        submitTask(p_pool, &group, runComparisonBatch, &batches[b]);
+    }
+    waitTaskGroup(p_pool, &group);
+    destroyTaskGroup(&group);
+    // merged in seed order, whatever the order the batches ran in
+    for (int b = 0; b < nbBatches; b++)
+    {
+        for (int s = 0; s < nbStrategies; s++)
+        {
+            for (int v = 0; v < NB_COMPARED_VALUES; v++)
+            {
+                mergeRunningStats(&comparison.values[s][v], &batches[b].values[s][v]);
+                mergeRunningStats(&comparison.differences[s][v], &batches[b].differences[s][v]);
+            }
+        }
+    }
+    free(batches);
+    return comparison;
+}
+
+void printComparison(const t_comparison *p_comparison, const t_compared_strategy *strategies, double z, FILE *file)
+{
+    static const char *names[NB_COMPARED_VALUES] = {"success", "phases", "planning ns/phase"};
+    fprintf(file, "%llu missions per strategy, reference %s\n", (unsigned long long)p_comparison->nbMissions,
+            strategies[0].name);
+    for (int s = 0; s < p_comparison->nbStrategies; s++)
+    {
+        fprintf(file, "%s\n", strategies[s].name);
+        for (int v = 0; v < NB_COMPARED_VALUES; v++)
+        {
+            t_running_stats values = p_comparison->values[s][v];
+            fprintf(file, "  %-18s %12.4f", names[v], values.mean);
+            if (s > 0)
+            {
+                t_running_stats reference = p_comparison->values[0][v];
+                t_running_stats difference = p_comparison->differences[s][v];
+                fprintf(file, "  diff %+12.4f +- %-10.4f", difference.mean, getHalfWidth(difference, z));
+                // independent samples would have the sum of the variances instead of the variance of the differences
+                if (difference.m2 > 0.0)
+                {
+                    fprintf(file, "  x%.1f missions if independent", (values.m2 + reference.m2) / difference.m2);
+                }
+            }
+            fprintf(file, "\n");
+        }
+    }
+    return;
+}
@@ -0,0 +1,77 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_COMPARE_H
+#define UNTITLED1_COMPARE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "estimate.h"
+#include "mission.h"
+#include "pool.h"
+
+/**
+ * @brief Maximal number of strategies compared together
+ */
+#define COMPARE_MAX_STRATEGIES 8
+
+/**
+ * @brief Enum for the values measured on each mission of a strategy
+ */
+typedef enum e_compared_value
+{
+    COMPARED_SUCCESS,       // 1 if the base station was reached, 0 otherwise
+    COMPARED_PHASES,        // number of phases of the mission
+    COMPARED_PLANNING_NS,   // mean time spent in the strategy per phase, in nanoseconds
+    NB_COMPARED_VALUES
+} t_compared_value;
+
+/**
+ * @brief Structure for a strategy taking part in a comparison
+ */
+typedef struct s_compared_strategy
+{
+    char        *name;
+    t_strategy  strategy;
+    void        *ctx;       // must be safe to use from several threads
+} t_compared_strategy;
+
+/**
+ * @brief Structure for the result of a comparison with common random numbers
+ * differences[i] are the paired differences strategy i - strategy 0, mission by mission
+ */
+typedef struct s_comparison
+{
+    int             nbStrategies;
+    uint64_t        nbMissions;
+    t_running_stats values[COMPARE_MAX_STRATEGIES][NB_COMPARED_VALUES];
+    t_running_stats differences[COMPARE_MAX_STRATEGIES][NB_COMPARED_VALUES];
+} t_comparison;
+
+/**
+ * @brief Function to run strategies in lockstep : every seed is played by every strategy from the same start
+ * localisation with the same draw at each phase, so the differences between them only come from their choices
+ * @param p_config : pointer to the parameters of the missions (its strategy is ignored)
+ * @param strategies : the strategies, the first one being the reference of the differences
+ * @param nbStrategies : the number of strategies (at most COMPARE_MAX_STRATEGIES)
+ * @param p_pool : pointer to the pool running batches of seeds
+ * @param seed_begin : the first seed
+ * @param seed_end : the seed after the last one
+ * @param batchSize : the number of seeds per task
+ * @return the comparison
+ */
+t_comparison compareStrategies(const t_mission_config *, const t_compared_strategy *, int, t_pool *, uint64_t, uint64_t, int);
+
+/**
+ * @brief Function to print a comparison : means, paired differences with their confidence intervals, and the
+ * factor of missions an independent sampling would need for the same precision
+ * @param p_comparison : pointer to the comparison
+ * @param strategies : the strategies compared
+ * @param z : the quantile of the confidence level
+ * @param file : the stream to print to
+ * @return none
+ */
+void printComparison(const t_comparison *, const t_compared_strategy *, double, FILE *);
+
+#endif //UNTITLED1_COMPARE_H
@@ -0,0 +1,183 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cpu.h"
+#include "costplane.h"
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to get the smallest width (0, 4, 8, 16 or 32 bits) holding a delta
+ * @param range : the largest delta
+ * @return the width in bits
+ */
+int getDeltaWidth(uint32_t);
+
+/* definition of local functions */
+
+int getDeltaWidth(uint32_t range)
+{
+    if (range == 0)
+    {
+        return 0;
+    }
+    if (range < (1u << 4))
+    {
+        return 4;
+    }
+    if (range < (1u << 8))
+    {
+        return 8;
+    }
+    if (range < (1u << 16))
+    {
+        return 16;
+    }
+    return 32;
+}
+
+/* definitions of exported functions */
+
+t_cost_plane createCostPlane(t_map map)
+{
+    t_cost_plane plane;
+    plane.x_max = map.x_max;
+    plane.y_max = map.y_max;
+    plane.blocks_x = (map.x_max + COST_BLOCK_SIDE - 1) / COST_BLOCK_SIDE;
+    plane.blocks_y = (map.y_max + COST_BLOCK_SIDE - 1) / COST_BLOCK_SIDE;
+    int nbBlocks = plane.blocks_x * plane.blocks_y;
+    plane.bases = (int32_t *)malloc(nbBlocks * sizeof(int32_t));
+    plane.offsets = (uint32_t *)malloc((nbBlocks + 1) * sizeof(uint32_t));
+
+    // first pass : base and width of each block
+    int *widths = (int *)malloc(nbBlocks * sizeof(int));
+    plane.offsets[0] = 0;
+    for (int b = 0; b < nbBlocks; b++)
+    {
+        int x0 = (b % plane.blocks_x) * COST_BLOCK_SIDE;
+        int y0 = (b / plane.blocks_x) * COST_BLOCK_SIDE;
+        int low = map.costs[y0][x0], high = low;
+        for (int y = y0; y < y0 + COST_BLOCK_SIDE && y < map.y_max; y++)
+        {
+            for (int x = x0; x < x0 + COST_BLOCK_SIDE && x < map.x_max; x++)
+            {
+                low = (map.costs[y][x] < low) ? map.costs[y][x] : low;
+                high = (map.costs[y][x] > high) ? map.costs[y][x] : high;
+            }
+        }
+        plane.bases[b] = low;
+        widths[b] = getDeltaWidth((uint32_t)high - (uint32_t)low);
+        plane.offsets[b + 1] = plane.offsets[b] + widths[b] * DELTA_BLOCK_CELLS / 8;
+    }
+
+    // second pass : the deltas, cells beyond the map having a delta of 0
+    plane.deltas = (uint8_t *)calloc(plane.offsets[nbBlocks] + 1, 1);
+    for (int b = 0; b < nbBlocks; b++)
+    {
+        int x0 = (b % plane.blocks_x) * COST_BLOCK_SIDE;
+        int y0 = (b / plane.blocks_x) * COST_BLOCK_SIDE;
+        uint8_t *deltas = plane.deltas + plane.offsets[b];
+        for (int y = y0; y < y0 + COST_BLOCK_SIDE && y < map.y_max; y++)
+        {
+            for (int x = x0; x < x0 + COST_BLOCK_SIDE && x < map.x_max; x++)
+            {
+                int i = (y - y0) * COST_BLOCK_SIDE + (x - x0);
+                uint32_t delta = (uint32_t)map.costs[y][x] - (uint32_t)plane.bases[b];
+                switch (widths[b])
+                {
+                    case 0:
+                        break;
+                    case 4:
+                        deltas[i >> 1] |= (uint8_t)(delta << ((i & 1) * 4));
+                        break;
+                    case 8:
+                        deltas[i] = (uint8_t)delta;
+                        break;
+                    case 16:
+                        deltas[2 * i] = (uint8_t)delta;
+                        deltas[2 * i + 1] = (uint8_t)(delta >> 8);
+                        break;
+                    default:
+                        memcpy(deltas + 4 * i, &delta, 4);
+                        break;
+                }
+            }
+        }
+    }
+    free(widths);
+    return plane;
+}
+
+void freeCostPlane(t_cost_plane *p_plane)
+{
+    free(p_plane->bases);
+    free(p_plane->offsets);
+    free(p_plane->deltas);
+    p_plane->bases = NULL;
+    p_plane->offsets = NULL;
+    p_plane->deltas = NULL;
+    return;
+}
+
+int getPlaneCost(const t_cost_plane *p_plane, t_position pos)
+{
+    assert(isValidLocalisation(pos, p_plane->x_max, p_plane->y_max));
+    int b = (pos.y / COST_BLOCK_SIDE) * p_plane->blocks_x + pos.x / COST_BLOCK_SIDE;
+    int i = (pos.y % COST_BLOCK_SIDE) * COST_BLOCK_SIDE + pos.x % COST_BLOCK_SIDE;
+    const uint8_t *deltas = p_plane->deltas + p_plane->offsets[b];
+    switch ((p_plane->offsets[b + 1] - p_plane->offsets[b]) / 8)
+    {
+        case 0:
+            return p_plane->bases[b];
+        case 4:
+            return p_plane->bases[b] + ((deltas[i >> 1] >> ((i & 1) * 4)) & 0xF);
+        case 8:
+            return p_plane->bases[b] + deltas[i];
+        case 16:
+            return p_plane->bases[b] + (deltas[2 * i] | (deltas[2 * i + 1] << 8));
+        default:
+        {
+            uint32_t delta;
+            memcpy(&delta, deltas + 4 * i, 4);
+            return (int)((uint32_t)p_plane->bases[b] + delta);
+        }
+    }
+}
+
+void decodeCostBlock(const t_cost_plane *p_plane, int block, int *out)
+{
+    assert(block >= 0 && block < p_plane->blocks_x * p_plane->blocks_y);
+    int width = (int)(p_plane->offsets[block + 1] - p_plane->offsets[block]) / 8;
+    _kernels.decodeDeltas(p_plane->deltas + p_plane->offsets[block], width, p_plane->bases[block], out);
+    return;
+}
+
+void expandCostPlane(const t_cost_plane *p_plane, t_map map)
+{
+    assert(map.x_max == p_plane->x_max && map.y_max == p_plane->y_max);
+    int block[DELTA_BLOCK_CELLS];
+    for (int b = 0; b < p_plane->blocks_x * p_plane->blocks_y; b++)
+    {
+        int x0 = (b % p_plane->blocks_x) * COST_BLOCK_SIDE;
+        int y0 = (b / p_plane->blocks_x) * COST_BLOCK_SIDE;
+        int width = (x0 + COST_BLOCK_SIDE <= map.x_max) ? COST_BLOCK_SIDE : map.x_max - x0;
+        decodeCostBlock(p_plane, b, block);
+        for (int y = y0; y < y0 + COST_BLOCK_SIDE && y < map.y_max; y++)
+        {
+            memcpy(map.costs[y] + x0, block + (y - y0) * COST_BLOCK_SIDE, width * sizeof(int));
+        }
+    }
+    return;
+}
+
+size_t getCostPlaneSize(const t_cost_plane *p_plane)
+{
+    int nbBlocks = p_plane->blocks_x * p_plane->blocks_y;
+    return sizeof(t_cost_plane) + nbBlocks * sizeof(int32_t) + (nbBlocks + 1) * sizeof(uint32_t)
+           + p_plane->offsets[nbBlocks] + 1;
+}
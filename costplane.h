@@ -0,0 +1,82 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_COSTPLANE_H
+#define UNTITLED1_COSTPLANE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "loc.h"
+#include "map.h"
+
+/**
+ * @brief Side of the square blocks of a cost plane (a block holds DELTA_BLOCK_CELLS cells)
+ */
+#define COST_BLOCK_SIDE 8
+
+/**
+ * @brief Structure for the compressed costs of a map
+ * the map is cut into blocks of 8 x 8 cells; a block stores its minimal cost and, for each cell, the difference
+ * to it on 0, 4, 8, 16 or 32 bits : the smallest width that fits the block. Neighbour cells differ by a soil
+ * cost, so most blocks need 4 or 8 bits per cell.
+ */
+typedef struct s_cost_plane
+{
+    int         x_max;
+    int         y_max;
+    int         blocks_x;   // number of blocks in a row of blocks
+    int         blocks_y;
+    int32_t     *bases;     // minimal cost of each block
+    uint32_t    *offsets;   // offset of the deltas of each block, offsets[nbBlocks] is the size of the deltas;
+                            // a block of width w bits takes 8 w bytes, so its width is the difference of offsets / 8
+    uint8_t     *deltas;
+} t_cost_plane;
+
+/**
+ * @brief Function to compress the costs of a map
+ * @param map : the map, whose costs are computed
+ * @return the cost plane
+ */
+t_cost_plane createCostPlane(t_map);
+
+/**
+ * @brief Function to free a cost plane
+ * @param p_plane : pointer to the cost plane
+ * @return none
+ */
+void freeCostPlane(t_cost_plane *);
+
+/**
+ * @brief Function to get the cost of a cell of a cost plane, in constant time
+ * @param p_plane : pointer to the cost plane
+ * @param pos : the position of the cell
+ * @return the cost
+ */
+int getPlaneCost(const t_cost_plane *, t_position);
+
+/**
+ * @brief Function to decode all the costs of a block (with the SIMD kernel of the CPU)
+ * @param p_plane : pointer to the cost plane
+ * @param block : the index of the block, row of blocks by row of blocks
+ * @param out : array receiving the DELTA_BLOCK_CELLS costs, row by row (cells beyond the map hold the base)
+ * @return none
+ */
+void decodeCostBlock(const t_cost_plane *, int, int *);
+
+/**
+ * @brief Function to decode a cost plane into the cost arrays of a map of the same dimensions
+ * @param p_plane : pointer to the cost plane
+ * @param map : the map receiving the costs
+ * @return none
+ */
+void expandCostPlane(const t_cost_plane *, t_map);
+
+/**
+ * @brief Function to get the memory used by a cost plane
+ * @param p_plane : pointer to the cost plane
+ * @return the size in bytes
+ */
+size_t getCostPlaneSize(const t_cost_plane *);
+
+#endif //UNTITLED1_COSTPLANE_H
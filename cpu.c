@@ -0,0 +1,690 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cpu.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CPU_X86 1
+#else
+#define CPU_X86 0
+#endif
+
+// the kernels read the soils as 32 bits integers
+_Static_assert(sizeof(t_soil) == sizeof(int), "t_soil must be stored as an int");
+
+/**
+ * @brief Names of the levels, indexed by t_cpu_level
+ */
+static const char *_cpu_level_names[4] = {"scalar", "sse4.2", "avx2", "avx512"};
+
+/**
+ * @brief The level the kernels are bound to
+ */
+static t_cpu_level _cpu_level = CPU_SCALAR;
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to detect the best level supported by the CPU
+ * @return the level
+ */
+t_cpu_level detectCpuLevel(void);
+
+/**
+ * @brief function to bind the kernels of the process at startup
+ * @return none
+ */
+void bindKernelsAtStartup(void) __attribute__((constructor));
+
+/**
+ * @brief scalar variants of the kernels (see t_kernels)
+ */
+int rowMinFalseCrevasseScalar(const t_soil *, const int *, int, int, int *);
+void rowMin5Scalar(const int *, const int *, const int *, int *, int);
+void decodeDeltasScalar(const unsigned char *, int, int, int *);
+int scanSoilRowScalar(const t_soil *, int, int *, int *);
+
+#if CPU_X86
+/**
+ * @brief SSE4.2, AVX2 and AVX-512 variants of the kernels (see t_kernels)
+ */
+int rowMinFalseCrevasseSse42(const t_soil *, const int *, int, int, int *);
+int rowMinFalseCrevasseAvx2(const t_soil *, const int *, int, int, int *);
+int rowMinFalseCrevasseAvx512(const t_soil *, const int *, int, int, int *);
+void rowMin5Sse42(const int *, const int *, const int *, int *, int);
+void rowMin5Avx2(const int *, const int *, const int *, int *, int);
+void rowMin5Avx512(const int *, const int *, const int *, int *, int);
+void decodeDeltasSse42(const unsigned char *, int, int, int *);
+void decodeDeltasAvx2(const unsigned char *, int, int, int *);
+int scanSoilRowSse42(const t_soil *, int, int *, int *);
+int scanSoilRowAvx2(const t_soil *, int, int *, int *);
+int scanSoilRowAvx512(const t_soil *, int, int *, int *);
+#endif
+
+/**
+ * @brief function to get the first column of a row holding a given false crevasse cost
+ * @param soils : the soils of the row
+ * @param costs : the costs of the row
+ * @param n : the number of cells
+ * @param cost : the cost looked for
+ * @return the column
+ */
+int findFalseCrevasseColumn(const t_soil *, const int *, int, int);
+
+/**
+ * @brief function to compute the minimum of a cell and its 4 neighbours (edges of the row included)
+ * @param up : the row above or NULL
+ * @param row : the row
+ * @param down : the row below or NULL
+ * @param n : the number of cells
+ * @param j : the column
+ * @return the minimum
+ */
+int min5At(const int *, const int *, const int *, int, int);
+
+/* definition of local functions */
+
+t_cpu_level detectCpuLevel(void)
+{
+#if CPU_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return CPU_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return CPU_AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.2"))
+    {
+        return CPU_SSE42;
+    }
+#endif
+    return CPU_SCALAR;
+}
+
+void bindKernelsAtStartup(void)
+{
+    initCpuDispatch();
+    return;
+}
+
+int findFalseCrevasseColumn(const t_soil *soils, const int *costs, int n, int cost)
+{
+    for (int j = 0; j < n; j++)
+    {
+        if (soils[j] != CREVASSE && costs[j] == cost)
+        {
+            return j;
+        }
+    }
+    return -1;
+}
+
+int min5At(const int *up, const int *row, const int *down, int n, int j)
+{
+    int m = row[j];
+    if (j > 0 && row[j - 1] < m)
+    {
+        m = row[j - 1];
+    }
+    if (j < n - 1 && row[j + 1] < m)
+    {
+        m = row[j + 1];
+    }
+    if (up != NULL && up[j] < m)
+    {
+        m = up[j];
+    }
+    if (down != NULL && down[j] < m)
+    {
+        m = down[j];
+    }
+    return m;
+}
+
+int rowMinFalseCrevasseScalar(const t_soil *soils, const int *costs, int n, int threshold, int *p_min)
+{
+    int best = -1;
+    for (int j = 0; j < n; j++)
+    {
+        if (soils[j] != CREVASSE && costs[j] > threshold && costs[j] < *p_min)
+        {
+            *p_min = costs[j];
+            best = j;
+        }
+    }
+    return best;
+}
+
+void rowMin5Scalar(const int *up, const int *row, const int *down, int *out, int n)
+{
+    for (int j = 0; j < n; j++)
+    {
+        out[j] = min5At(up, row, down, n, j);
+    }
+    return;
+}
+
+void decodeDeltasScalar(const unsigned char *deltas, int width, int base, int *out)
+{
+    for (int i = 0; i < DELTA_BLOCK_CELLS; i++)
+    {
+        switch (width)
+        {
+            case 0:
+                out[i] = base;
+                break;
+            case 4:
+                out[i] = base + ((deltas[i >> 1] >> ((i & 1) * 4)) & 0xF);
+                break;
+            case 8:
+                out[i] = base + deltas[i];
+                break;
+            case 16:
+                out[i] = base + (deltas[2 * i] | (deltas[2 * i + 1] << 8));
+                break;
+            default:
+            {
+                unsigned int delta;
+                memcpy(&delta, deltas + 4 * i, 4);
+                out[i] = base + (int)delta;
+                break;
+            }
+        }
+    }
+    return;
+}
+
+int scanSoilRowScalar(const t_soil *soils, int n, int *counts, int *columns)
+{
+    int nb = 0;
+    for (int j = 0; j < n; j++)
+    {
+        unsigned int s = (unsigned int)soils[j];
+        if (s <= CREVASSE)
+        {
+            counts[s]++;
+        }
+        if (s - PLAIN > CREVASSE - PLAIN)
+        {
+            columns[nb++] = j;
+        }
+    }
+    return nb;
+}
+
+#if CPU_X86
+
+__attribute__((target("sse4.2")))
+int rowMinFalseCrevasseSse42(const t_soil *soils, const int *costs, int n, int threshold, int *p_min)
+{
+    const __m128i crevasse = _mm_set1_epi32(CREVASSE);
+    const __m128i above = _mm_set1_epi32(threshold);
+    const __m128i none = _mm_set1_epi32(INT_MAX);
+    __m128i vmin = none;
+    int j = 0;
+    for (; j + 4 <= n; j += 4)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i *)(soils + j));
+        __m128i c = _mm_loadu_si128((const __m128i *)(costs + j));
+        __m128i valid = _mm_andnot_si128(_mm_cmpeq_epi32(s, crevasse), _mm_cmpgt_epi32(c, above));
+        vmin = _mm_min_epi32(vmin, _mm_blendv_epi8(none, c, valid));
+    }
+    vmin = _mm_min_epi32(vmin, _mm_shuffle_epi32(vmin, _MM_SHUFFLE(1, 0, 3, 2)));
+    vmin = _mm_min_epi32(vmin, _mm_shuffle_epi32(vmin, _MM_SHUFFLE(2, 3, 0, 1)));
+    int m = _mm_cvtsi128_si32(vmin);
+    for (; j < n; j++)
+    {
+        if (soils[j] != CREVASSE && costs[j] > threshold && costs[j] < m)
+        {
+            m = costs[j];
+        }
+    }
+    if (m >= *p_min)
+    {
+        return -1;
+    }
+    *p_min = m;
+    return findFalseCrevasseColumn(soils, costs, n, m);
+}
+
+__attribute__((target("avx2")))
+int rowMinFalseCrevasseAvx2(const t_soil *soils, const int *costs, int n, int threshold, int *p_min)
+{
+    const __m256i crevasse = _mm256_set1_epi32(CREVASSE);
+    const __m256i above = _mm256_set1_epi32(threshold);
+    const __m256i none = _mm256_set1_epi32(INT_MAX);
+    __m256i vmin = none;
+    int j = 0;
+    for (; j + 8 <= n; j += 8)
+    {
+        __m256i s = _mm256_loadu_si256((const __m256i *)(soils + j));
+        __m256i c = _mm256_loadu_si256((const __m256i *)(costs + j));
+        __m256i valid = _mm256_andnot_si256(_mm256_cmpeq_epi32(s, crevasse), _mm256_cmpgt_epi32(c, above));
+        vmin = _mm256_min_epi32(vmin, _mm256_blendv_epi8(none, c, valid));
+    }
+    __m128i half = _mm_min_epi32(_mm256_castsi256_si128(vmin), _mm256_extracti128_si256(vmin, 1));
+    half = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    int m = _mm_cvtsi128_si32(half);
+    for (; j < n; j++)
+    {
+        if (soils[j] != CREVASSE && costs[j] > threshold && costs[j] < m)
+        {
+            m = costs[j];
+        }
+    }
+    if (m >= *p_min)
+    {
+        return -1;
+    }
+    *p_min = m;
+    return findFalseCrevasseColumn(soils, costs, n, m);
+}
+
+__attribute__((target("avx512f")))
+int rowMinFalseCrevasseAvx512(const t_soil *soils, const int *costs, int n, int threshold, int *p_min)
+{
+    const __m512i crevasse = _mm512_set1_epi32(CREVASSE);
+    const __m512i above = _mm512_set1_epi32(threshold);
+    __m512i vmin = _mm512_set1_epi32(INT_MAX);
+    int j = 0;
+    for (; j < n; j += 16)
+    {
+        // the tail is handled by masked loads
+        __mmask16 lanes = (n - j >= 16) ? 0xFFFF : (__mmask16)((1u << (n - j)) - 1);
+        __m512i s = _mm512_maskz_loadu_epi32(lanes, soils + j);
+        __m512i c = _mm512_maskz_loadu_epi32(lanes, costs + j);
+        __mmask16 valid = _mm512_mask_cmpneq_epi32_mask(lanes, s, crevasse) & _mm512_cmpgt_epi32_mask(c, above);
+        vmin = _mm512_mask_min_epi32(vmin, valid, vmin, c);
+    }
+    int m = _mm512_reduce_min_epi32(vmin);
+    if (m >= *p_min)
+    {
+        return -1;
+    }
+    *p_min = m;
+    return findFalseCrevasseColumn(soils, costs, n, m);
+}
+
+__attribute__((target("sse4.2")))
+void rowMin5Sse42(const int *up, const int *row, const int *down, int *out, int n)
+{
+    if (n < 6)
+    {
+        rowMin5Scalar(up, row, down, out, n);
+        return;
+    }
+    out[0] = min5At(up, row, down, n, 0);
+    int j = 1;
+    for (; j + 4 <= n - 1; j += 4)
+    {
+        __m128i m = _mm_loadu_si128((const __m128i *)(row + j));
+        m = _mm_min_epi32(m, _mm_loadu_si128((const __m128i *)(row + j - 1)));
+        m = _mm_min_epi32(m, _mm_loadu_si128((const __m128i *)(row + j + 1)));
+        if (up != NULL)
+        {
+            m = _mm_min_epi32(m, _mm_loadu_si128((const __m128i *)(up + j)));
+        }
+        if (down != NULL)
+        {
+            m = _mm_min_epi32(m, _mm_loadu_si128((const __m128i *)(down + j)));
+        }
+        _mm_storeu_si128((__m128i *)(out + j), m);
+    }
+    for (; j < n; j++)
+    {
+        out[j] = min5At(up, row, down, n, j);
+    }
+    return;
+}
+
+__attribute__((target("avx2")))
+void rowMin5Avx2(const int *up, const int *row, const int *down, int *out, int n)
+{
+    if (n < 10)
+    {
+        rowMin5Scalar(up, row, down, out, n);
+        return;
+    }
+    out[0] = min5At(up, row, down, n, 0);
+    int j = 1;
+    for (; j + 8 <= n - 1; j += 8)
+    {
+        __m256i m = _mm256_loadu_si256((const __m256i *)(row + j));
+        m = _mm256_min_epi32(m, _mm256_loadu_si256((const __m256i *)(row + j - 1)));
+        m = _mm256_min_epi32(m, _mm256_loadu_si256((const __m256i *)(row + j + 1)));
+        if (up != NULL)
+        {
+            m = _mm256_min_epi32(m, _mm256_loadu_si256((const __m256i *)(up + j)));
+        }
+        if (down != NULL)
+        {
+            m = _mm256_min_epi32(m, _mm256_loadu_si256((const __m256i *)(down + j)));
+        }
+        _mm256_storeu_si256((__m256i *)(out + j), m);
+    }
+    for (; j < n; j++)
+    {
+        out[j] = min5At(up, row, down, n, j);
+    }
+    return;
+}
+
+__attribute__((target("avx512f")))
+void rowMin5Avx512(const int *up, const int *row, const int *down, int *out, int n)
+{
+    if (n < 18)
+    {
+        rowMin5Scalar(up, row, down, out, n);
+        return;
+    }
+    out[0] = min5At(up, row, down, n, 0);
+    int j = 1;
+    for (; j + 16 <= n - 1; j += 16)
+    {
+        __m512i m = _mm512_loadu_si512(row + j);
+        m = _mm512_min_epi32(m, _mm512_loadu_si512(row + j - 1));
+        m = _mm512_min_epi32(m, _mm512_loadu_si512(row + j + 1));
+        if (up != NULL)
+        {
+            m = _mm512_min_epi32(m, _mm512_loadu_si512(up + j));
+        }
+        if (down != NULL)
+        {
+            m = _mm512_min_epi32(m, _mm512_loadu_si512(down + j));
+        }
+        _mm512_storeu_si512(out + j, m);
+    }
+    for (; j < n; j++)
+    {
+        out[j] = min5At(up, row, down, n, j);
+    }
+    return;
+}
+
+__attribute__((target("sse4.2")))
+void decodeDeltasSse42(const unsigned char *deltas, int width, int base, int *out)
+{
+    const __m128i vbase = _mm_set1_epi32(base);
+    if (width == 4 || width == 8)
+    {
+        for (int i = 0; i < DELTA_BLOCK_CELLS; i += 16)
+        {
+            __m128i bytes;
+            if (width == 4)
+            {
+                // 8 bytes hold 16 nibbles : low and high nibbles are interleaved back in cell order
+                __m128i packed = _mm_loadl_epi64((const __m128i *)(deltas + i / 2));
+                __m128i low = _mm_and_si128(packed, _mm_set1_epi8(0x0F));
+                __m128i high = _mm_and_si128(_mm_srli_epi16(packed, 4), _mm_set1_epi8(0x0F));
+                bytes = _mm_unpacklo_epi8(low, high);
+            }
+            else
+            {
+                bytes = _mm_loadu_si128((const __m128i *)(deltas + i));
+            }
+            for (int k = 0; k < 4; k++)
+            {
+                _mm_storeu_si128((__m128i *)(out + i + 4 * k), _mm_add_epi32(vbase, _mm_cvtepu8_epi32(bytes)));
+                bytes = _mm_srli_si128(bytes, 4);
+            }
+        }
+        return;
+    }
+    if (width == 16)
+    {
+        for (int i = 0; i < DELTA_BLOCK_CELLS; i += 4)
+        {
+            __m128i words = _mm_loadl_epi64((const __m128i *)(deltas + 2 * i));
+            _mm_storeu_si128((__m128i *)(out + i), _mm_add_epi32(vbase, _mm_cvtepu16_epi32(words)));
+        }
+        return;
+    }
+    decodeDeltasScalar(deltas, width, base, out);
+    return;
+}
+
+__attribute__((target("avx2")))
+void decodeDeltasAvx2(const unsigned char *deltas, int width, int base, int *out)
+{
+    const __m256i vbase = _mm256_set1_epi32(base);
+    if (width == 4 || width == 8)
+    {
+        for (int i = 0; i < DELTA_BLOCK_CELLS; i += 16)
+        {
+            __m128i bytes;
+            if (width == 4)
+            {
+                __m128i packed = _mm_loadl_epi64((const __m128i *)(deltas + i / 2));
+                __m128i low = _mm_and_si128(packed, _mm_set1_epi8(0x0F));
+                __m128i high = _mm_and_si128(_mm_srli_epi16(packed, 4), _mm_set1_epi8(0x0F));
+                bytes = _mm_unpacklo_epi8(low, high);
+            }
+            else
+            {
+                bytes = _mm_loadu_si128((const __m128i *)(deltas + i));
+            }
+            _mm256_storeu_si256((__m256i *)(out + i), _mm256_add_epi32(vbase, _mm256_cvtepu8_epi32(bytes)));
+            _mm256_storeu_si256((__m256i *)(out + i + 8),
+                                _mm256_add_epi32(vbase, _mm256_cvtepu8_epi32(_mm_srli_si128(bytes, 8))));
+        }
+        return;
+    }
+    if (width == 16)
+    {
+        for (int i = 0; i < DELTA_BLOCK_CELLS; i += 8)
+        {
+            __m128i words = _mm_loadu_si128((const __m128i *)(deltas + 2 * i));
+            _mm256_storeu_si256((__m256i *)(out + i), _mm256_add_epi32(vbase, _mm256_cvtepu16_epi32(words)));
+        }
+        return;
+    }
+    if (width == 32)
+    {
+        for (int i = 0; i < DELTA_BLOCK_CELLS; i += 8)
+        {
+            __m256i values = _mm256_loadu_si256((const __m256i *)(deltas + 4 * i));
+            _mm256_storeu_si256((__m256i *)(out + i), _mm256_add_epi32(vbase, values));
+        }
+        return;
+    }
+    decodeDeltasScalar(deltas, width, base, out);
+    return;
+}
+
+__attribute__((target("sse4.2")))
+int scanSoilRowSse42(const t_soil *soils, int n, int *counts, int *columns)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i above = _mm_set1_epi32(CREVASSE + 1);
+    __m128i acc[CREVASSE + 1];
+    for (int v = 0; v <= CREVASSE; v++)
+    {
+        acc[v] = zero;
+    }
+    int nb = 0;
+    int j = 0;
+    for (; j + 4 <= n; j += 4)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i *)(soils + j));
+        for (int v = 0; v <= CREVASSE; v++)
+        {
+            // a lane equal to v is -1 : subtracting it counts the lane
+            acc[v] = _mm_sub_epi32(acc[v], _mm_cmpeq_epi32(s, _mm_set1_epi32(v)));
+        }
+        __m128i regular = _mm_and_si128(_mm_cmpgt_epi32(s, zero), _mm_cmpgt_epi32(above, s));
+        int special = ~_mm_movemask_ps(_mm_castsi128_ps(regular)) & 0xF;
+        while (special != 0)
+        {
+            columns[nb++] = j + __builtin_ctz(special);
+            special &= special - 1;
+        }
+    }
+    for (int v = 0; v <= CREVASSE; v++)
+    {
+        __m128i a = _mm_add_epi32(acc[v], _mm_shuffle_epi32(acc[v], _MM_SHUFFLE(1, 0, 3, 2)));
+        a = _mm_add_epi32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1)));
+        counts[v] += _mm_cvtsi128_si32(a);
+    }
+    int tail = scanSoilRowScalar(soils + j, n - j, counts, columns + nb);
+    for (int i = nb; i < nb + tail; i++)
+    {
+        columns[i] += j;
+    }
+    return nb + tail;
+}
+
+__attribute__((target("avx2")))
+int scanSoilRowAvx2(const t_soil *soils, int n, int *counts, int *columns)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i above = _mm256_set1_epi32(CREVASSE + 1);
+    __m256i acc[CREVASSE + 1];
+    for (int v = 0; v <= CREVASSE; v++)
+    {
+        acc[v] = zero;
+    }
+    int nb = 0;
+    int j = 0;
+    for (; j + 8 <= n; j += 8)
+    {
+        __m256i s = _mm256_loadu_si256((const __m256i *)(soils + j));
+        for (int v = 0; v <= CREVASSE; v++)
+        {
+            acc[v] = _mm256_sub_epi32(acc[v], _mm256_cmpeq_epi32(s, _mm256_set1_epi32(v)));
+        }
+        __m256i regular = _mm256_and_si256(_mm256_cmpgt_epi32(s, zero), _mm256_cmpgt_epi32(above, s));
+        int special = ~_mm256_movemask_ps(_mm256_castsi256_ps(regular)) & 0xFF;
+        while (special != 0)
+        {
+            columns[nb++] = j + __builtin_ctz(special);
+            special &= special - 1;
+        }
+    }
+    for (int v = 0; v <= CREVASSE; v++)
+    {
+        __m128i a = _mm_add_epi32(_mm256_castsi256_si128(acc[v]), _mm256_extracti128_si256(acc[v], 1));
+        a = _mm_add_epi32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(1, 0, 3, 2)));
+        a = _mm_add_epi32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1)));
+        counts[v] += _mm_cvtsi128_si32(a);
+    }
+    int tail = scanSoilRowScalar(soils + j, n - j, counts, columns + nb);
+    for (int i = nb; i < nb + tail; i++)
+    {
+        columns[i] += j;
+    }
+    return nb + tail;
+}
+
+__attribute__((target("avx512f")))
+int scanSoilRowAvx512(const t_soil *soils, int n, int *counts, int *columns)
+{
+    const __m512i above = _mm512_set1_epi32(CREVASSE + 1);
+    int nb = 0;
+    for (int j = 0; j < n; j += 16)
+    {
+        // the tail is handled by masked loads
+        __mmask16 lanes = (n - j >= 16) ? 0xFFFF : (__mmask16)((1u << (n - j)) - 1);
+        __m512i s = _mm512_maskz_loadu_epi32(lanes, soils + j);
+        for (int v = 0; v <= CREVASSE; v++)
+        {
+            counts[v] += __builtin_popcount(_mm512_mask_cmpeq_epi32_mask(lanes, s, _mm512_set1_epi32(v)));
+        }
+        __mmask16 regular = _mm512_cmpgt_epi32_mask(s, _mm512_setzero_si512()) & _mm512_cmpgt_epi32_mask(above, s);
+        unsigned int special = lanes & ~regular;
+        while (special != 0)
+        {
+            columns[nb++] = j + __builtin_ctz(special);
+            special &= special - 1;
+        }
+    }
+    return nb;
+}
+
+#endif
+
+/* definitions of exported functions */
+
+t_kernels _kernels = {rowMinFalseCrevasseScalar, rowMin5Scalar, decodeDeltasScalar, scanSoilRowScalar};
+
+t_cpu_level initCpuDispatch(void)
+{
+    t_cpu_level level = detectCpuLevel();
+    const char *forced = getenv("MARC_CPU_LEVEL");
+    if (forced != NULL && *forced != '\0')
+    {
+        int found = 0;
+        for (int l = CPU_SCALAR; l <= CPU_AVX512; l++)
+        {
+            if (strcmp(forced, _cpu_level_names[l]) == 0)
+            {
+                found = 1;
+                if (l > (int)level)
+                {
+                    fprintf(stderr, "Warning: MARC_CPU_LEVEL=%s is not supported by this CPU, using %s\n",
+                            forced, _cpu_level_names[level]);
+                }
+                else
+                {
+                    level = l;
+                }
+            }
+        }
+        if (!found)
+        {
+            fprintf(stderr, "Warning: unknown MARC_CPU_LEVEL=%s, using %s\n", forced, _cpu_level_names[level]);
+        }
+    }
+    _kernels.rowMinFalseCrevasse = rowMinFalseCrevasseScalar;
+    _kernels.rowMin5 = rowMin5Scalar;
+    _kernels.decodeDeltas = decodeDeltasScalar;
+    _kernels.scanSoilRow = scanSoilRowScalar;
+#if CPU_X86
+    switch (level)
+    {
+        case CPU_AVX512:
+            _kernels.rowMinFalseCrevasse = rowMinFalseCrevasseAvx512;
+            _kernels.rowMin5 = rowMin5Avx512;
+            // a block is 64 cells : the AVX2 decoder already stores them in 8 instructions
+            _kernels.decodeDeltas = decodeDeltasAvx2;
+            _kernels.scanSoilRow = scanSoilRowAvx512;
+            break;
+        case CPU_AVX2:
+            _kernels.rowMinFalseCrevasse = rowMinFalseCrevasseAvx2;
+            _kernels.rowMin5 = rowMin5Avx2;
+            _kernels.decodeDeltas = decodeDeltasAvx2;
+            _kernels.scanSoilRow = scanSoilRowAvx2;
+            break;
+        case CPU_SSE42:
+            _kernels.rowMinFalseCrevasse = rowMinFalseCrevasseSse42;
+            _kernels.rowMin5 = rowMin5Sse42;
+            _kernels.decodeDeltas = decodeDeltasSse42;
+            _kernels.scanSoilRow = scanSoilRowSse42;
+            break;
+        default:
+            break;
+    }
+#endif
+    _cpu_level = level;
+    return level;
+}
+
+t_cpu_level getCpuLevel(void)
+{
+    return _cpu_level;
+}
+
+const char *getCpuLevelName(t_cpu_level level)
+{
+    return _cpu_level_names[level];
+}
@@ -0,0 +1,98 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_CPU_H
+#define UNTITLED1_CPU_H
+
+#include "map.h"
+
+/**
+ * @brief Number of cells of a block of deltas decoded by decodeDeltas
+ */
+#define DELTA_BLOCK_CELLS 64
+
+/**
+ * @brief Enum for the instruction set levels a kernel can be compiled for
+ */
+typedef enum e_cpu_level
+{
+    CPU_SCALAR,
+    CPU_SSE42,
+    CPU_AVX2,
+    CPU_AVX512
+} t_cpu_level;
+
+/**
+ * @brief Structure for the hot functions that have SIMD variants
+ * the pointers are bound to the best variant for the CPU by initCpuDispatch
+ */
+typedef struct s_kernels
+{
+    /**
+     * @brief find the cell of a row with the minimal cost > threshold that is not a crevasse
+     * @param soils : the soils of the row
+     * @param costs : the costs of the row
+     * @param n : the number of cells of the row
+     * @param threshold : the cost of a crevasse
+     * @param p_min : pointer to the best cost so far, lowered when the row has a smaller one
+     * @return the first column of the new minimum, -1 if the row has no cost smaller than *p_min
+     */
+    int (*rowMinFalseCrevasse)(const t_soil *, const int *, int, int, int *);
+
+    /**
+     * @brief compute the minimum of each cell and its 4 neighbours over a row
+     * @param up : the row above, NULL on the first row
+     * @param row : the row
+     * @param down : the row below, NULL on the last row
+     * @param out : the row receiving the minimums
+     * @param n : the number of cells of the rows
+     */
+    void (*rowMin5)(const int *, const int *, const int *, int *, int);
+
+    /**
+     * @brief decode the 64 deltas of a block of a cost plane and add them to the base of the block
+     * @param deltas : the packed deltas (4 bits : two cells per byte, low nibble first)
+     * @param width : the width of a delta in bits (0, 4, 8, 16 or 32)
+     * @param base : the base of the block
+     * @param out : the 64 costs
+     */
+    void (*decodeDeltas)(const unsigned char *, int, int, int *);
+
+    /**
+     * @brief count the soils of a row and list the cells that are not plain, erg, reg or crevasse
+     * @param soils : the soils of the row
+     * @param n : the number of cells of the row
+     * @param counts : the 5 counts of the soils, increased by the cells of the row with a valid soil
+     * @param columns : array of n columns receiving the columns of the base stations and of the invalid soils
+     * @return the number of columns written
+     */
+    int (*scanSoilRow)(const t_soil *, int, int *, int *);
+} t_kernels;
+
+/**
+ * @brief The kernels of the process, bound at startup
+ */
+extern t_kernels _kernels;
+
+/**
+ * @brief Function to detect the instruction set level of the CPU and bind the kernels to it
+ * the environment variable MARC_CPU_LEVEL (scalar, sse4.2, avx2 or avx512) forces a lower level
+ * @return the level the kernels were bound to
+ */
+t_cpu_level initCpuDispatch(void);
+
+/**
+ * @brief Function to get the level the kernels are bound to
+ * @return the level
+ */
+t_cpu_level getCpuLevel(void);
+
+/**
+ * @brief Function to get the name of a level, as used by MARC_CPU_LEVEL
+ * @param level : the level
+ * @return the name
+ */
+const char *getCpuLevelName(t_cpu_level);
+
+#endif //UNTITLED1_CPU_H
@@ -0,0 +1,459 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "critical.h"
+#include "heap.h"
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to get the neighbours of a cell that are not crevasses
+ * @param map : the map
+ * @param cell : the index of the cell
+ * @param neighbours : array of 4 indexes receiving the neighbours
+ * @return the number of neighbours written
+ */
+int getOpenNeighbours(t_map, int, int *);
+
+/**
+ * @brief function to check that a cell is in the subtree of another one
+ * @param p_tree : pointer to the tree
+ * @param cell : the cell
+ * @param root : the root of the subtree
+ * @return 1 if the path of the cell goes through the root, 0 otherwise
+ */
+int isInSubtree(const t_cost_tree *, int, int);
+
+/**
+ * @brief function to compare the effects of two cells
+ * @param a : pointer to the first cell
+ * @param b : pointer to the second cell
+ * @return 1 if a is more critical than b (ties are broken by row, then by column), 0 otherwise
+ */
+int isMoreCritical(const t_critical_cell *, const t_critical_cell *);
+
+/**
+ * @brief qsort comparison of critical cells, most critical first
+ * @param a : pointer to the first cell
+ * @param b : pointer to the second cell
+ * @return the comparison result
+ */
+int compareCriticalCells(const void *, const void *);
+
+/**
+ * @brief function to bound the effect of a crevasse on a cell with a detour through the 8 cells around it
+ * the children of the cell reconnect through the ring, and their subtrees keep their old paths down to them
+ * @param p_tree : pointer to the tree
+ * @param cell : the cell
+ * @return the bounds of the effect
+ */
+t_critical_cell boundCriticalCell(const t_cost_tree *, int);
+
+/**
+ * @brief function to compute the exact effect of a crevasse on a cell, with a Dijkstra restricted to its subtree
+ * seeded by the cells outside the subtree, whose costs do not change
+ * @param p_tree : pointer to the tree
+ * @param cell : the cell
+ * @param new_costs : scratch array of one cost per cell of the map
+ * @param p_heap : pointer to an empty heap
+ * @return the effect
+ */
+t_critical_cell repairCriticalCell(const t_cost_tree *, int, int *, t_heap *);
+
+/* definition of local functions */
+
+int getOpenNeighbours(t_map map, int cell, int *neighbours)
+{
+    t_position pos;
+    pos.x = cell % map.x_max;
+    pos.y = cell / map.x_max;
+    t_position around[4] = {LEFT(pos), RIGHT(pos), UP(pos), DOWN(pos)};
+    int nb = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        if (isValidLocalisation(around[i], map.x_max, map.y_max) && map.soils[around[i].y][around[i].x] != CREVASSE)
+        {
+            neighbours[nb++] = around[i].y * map.x_max + around[i].x;
+        }
+    }
+    return nb;
+}
+
+int isInSubtree(const t_cost_tree *p_tree, int cell, int root)
+{
+    return p_tree->costs[cell] != COST_UNDEF && p_tree->first[cell] >= p_tree->first[root]
+           && p_tree->first[cell] < p_tree->first[root] + p_tree->subtree[root];
+}
+
+int isMoreCritical(const t_critical_cell *a, const t_critical_cell *b)
+{
+    if (a->nbDisconnected != b->nbDisconnected)
+    {
+        return a->nbDisconnected > b->nbDisconnected;
+    }
+    if (a->impact != b->impact)
+    {
+        return a->impact > b->impact;
+    }
+    if (a->pos.y != b->pos.y)
+    {
+        return a->pos.y < b->pos.y;
+    }
+    return a->pos.x < b->pos.x;
+}
+
+int compareCriticalCells(const void *a, const void *b)
+{
+    const t_critical_cell *ca = (const t_critical_cell *)a;
+    const t_critical_cell *cb = (const t_critical_cell *)b;
+    if (isMoreCritical(ca, cb))
+    {
+        return -1;
+    }
+    return isMoreCritical(cb, ca);
+}
+
+t_critical_cell boundCriticalCell(const t_cost_tree *p_tree, int cell)
+{
+    // the ring is walked clockwise from the upper left corner : consecutive cells are neighbours
+    static const int ring_dx[8] = {-1, 0, 1, 1, 1, 0, -1, -1};
+    static const int ring_dy[8] = {-1, -1, -1, 0, 1, 1, 1, 0};
+    t_map map = p_tree->map;
+    t_critical_cell result;
+    result.pos.x = cell % map.x_max;
+    result.pos.y = cell / map.x_max;
+    result.subtree = p_tree->subtree[cell];
+    result.impact = 0;
+    result.nbDisconnected = 0;
+    result.exact = (result.subtree == 1);
+    if (result.exact)
+    {
+        // no path goes through a leaf
+        return result;
+    }
+
+    int ring[8];
+    long long values[8];
+    for (int i = 0; i < 8; i++)
+    {
+        int x = result.pos.x + ring_dx[i];
+        int y = result.pos.y + ring_dy[i];
+        ring[i] = -1;
+        values[i] = LLONG_MAX;
+        if (x < 0 || x >= map.x_max || y < 0 || y >= map.y_max || p_tree->costs[y * map.x_max + x] == COST_UNDEF)
+        {
+            continue;
+        }
+        ring[i] = y * map.x_max + x;
+        if (!isInSubtree(p_tree, ring[i], cell))
+        {
+            values[i] = p_tree->costs[ring[i]];
+            continue;
+        }
+        // a cell of the subtree can still step out of it directly
+        int neighbours[4];
+        int nb = getOpenNeighbours(map, ring[i], neighbours);
+        for (int n = 0; n < nb; n++)
+        {
+            if (neighbours[n] != cell && p_tree->costs[neighbours[n]] != COST_UNDEF && !isInSubtree(p_tree, neighbours[n], cell)
+                && p_tree->costs[neighbours[n]] + getSoilCost(map.soil_costs, map.soils[y][x]) < values[i])
+            {
+                values[i] = p_tree->costs[neighbours[n]] + getSoilCost(map.soil_costs, map.soils[y][x]);
+            }
+        }
+    }
+    // shortest paths along the ring (Bellman-Ford over 8 cells)
+    for (int pass = 0; pass < 8; pass++)
+    {
+        for (int i = 0; i < 8; i++)
+        {
+            int j = (i + 1) % 8;
+            if (ring[i] < 0 || ring[j] < 0)
+            {
+                continue;
+            }
+            int cost_i = getSoilCost(map.soil_costs, map.soils[ring[i] / map.x_max][ring[i] % map.x_max]);
+            int cost_j = getSoilCost(map.soil_costs, map.soils[ring[j] / map.x_max][ring[j] % map.x_max]);
+            if (values[i] != LLONG_MAX && values[i] + cost_j < values[j])
+            {
+                values[j] = values[i] + cost_j;
+            }
+            if (values[j] != LLONG_MAX && values[j] + cost_i < values[i])
+            {
+                values[i] = values[j] + cost_i;
+            }
+        }
+    }
+    // the children of the cell are its 4 neighbours on the ring, at odd positions
+    for (int i = 1; i < 8; i += 2)
+    {
+        if (ring[i] < 0 || p_tree->parent[ring[i]] != cell)
+        {
+            continue;
+        }
+        if (values[i] == LLONG_MAX)
+        {
+            // no detour : the whole subtree may be cut off
+            result.impact = LLONG_MAX;
+            result.nbDisconnected = result.subtree - 1;
+            return result;
+        }
+        result.impact += (long long)p_tree->subtree[ring[i]] * (values[i] - p_tree->costs[ring[i]]);
+    }
+    return result;
+}
+
+t_critical_cell repairCriticalCell(const t_cost_tree *p_tree, int cell, int *new_costs, t_heap *p_heap)
+{
+    t_map map = p_tree->map;
+    t_critical_cell result;
+    result.pos.x = cell % map.x_max;
+    result.pos.y = cell / map.x_max;
+    result.subtree = p_tree->subtree[cell];
+    result.impact = 0;
+    result.nbDisconnected = 0;
+    result.exact = 1;
+    int begin = p_tree->first[cell] + 1;
+    int end = p_tree->first[cell] + p_tree->subtree[cell];
+    int neighbours[4];
+
+    for (int i = begin; i < end; i++)
+    {
+        new_costs[p_tree->preorder[i]] = INT_MAX;
+    }
+    // the cells outside the subtree keep their costs : they seed the search
+    for (int i = begin; i < end; i++)
+    {
+        int u = p_tree->preorder[i];
+        int self_cost = getSoilCost(map.soil_costs, map.soils[u / map.x_max][u % map.x_max]);
+        int nb = getOpenNeighbours(map, u, neighbours);
+        for (int n = 0; n < nb; n++)
+        {
+            int v = neighbours[n];
+            if (v != cell && p_tree->costs[v] != COST_UNDEF && !isInSubtree(p_tree, v, cell)
+                && p_tree->costs[v] + self_cost < new_costs[u])
+            {
+                new_costs[u] = p_tree->costs[v] + self_cost;
+            }
+        }
+        if (new_costs[u] != INT_MAX)
+        {
+            t_position pos;
+            pos.x = u % map.x_max;
+            pos.y = u / map.x_max;
+            pushHeap(p_heap, pos, new_costs[u]);
+        }
+    }
+    while (p_heap->nbElts > 0)
+    {
+        t_heap_node node = popHeap(p_heap);
+        int u = node.pos.y * map.x_max + node.pos.x;
+        if (node.cost != new_costs[u])
+        {
+            continue;
+        }
+        int nb = getOpenNeighbours(map, u, neighbours);
+        for (int n = 0; n < nb; n++)
+        {
+            int v = neighbours[n];
+            if (v == cell || !isInSubtree(p_tree, v, cell))
+            {
+                continue;
+            }
+            int cost = node.cost + getSoilCost(map.soil_costs, map.soils[v / map.x_max][v % map.x_max]);
+            if (cost < new_costs[v])
+            {
+                new_costs[v] = cost;
+                t_position pos;
+                pos.x = v % map.x_max;
+                pos.y = v / map.x_max;
+                pushHeap(p_heap, pos, cost);
+            }
+        }
+    }
+    for (int i = begin; i < end; i++)
+    {
+        int u = p_tree->preorder[i];
+        if (new_costs[u] == INT_MAX)
+        {
+            result.nbDisconnected++;
+        }
+        else
+        {
+            result.impact += new_costs[u] - p_tree->costs[u];
+        }
+    }
+    return result;
+}
+
+/* definitions of exported functions */
+
+t_cost_tree createCostTree(t_map map)
+{
+    t_cost_tree tree;
+    int nbCells = map.x_max * map.y_max;
+    int base = -1;
+    tree.map = map;
+    tree.costs = (int *)malloc(nbCells * sizeof(int));
+    tree.parent = (int *)malloc(nbCells * sizeof(int));
+    tree.subtree = (int *)calloc(nbCells, sizeof(int));
+    tree.first = (int *)malloc(nbCells * sizeof(int));
+    tree.preorder = (int *)malloc(nbCells * sizeof(int));
+    for (int c = 0; c < nbCells; c++)
+    {
+        tree.costs[c] = COST_UNDEF;
+        tree.parent[c] = -1;
+        tree.first[c] = -1;
+        if (base < 0 && map.soils[c / map.x_max][c % map.x_max] == BASE_STATION)
+        {
+            base = c;
+        }
+    }
+    if (base < 0)
+    {
+        fprintf(stderr, "Error: base station not found in the map\n");
+        exit(1);
+    }
+
+    // Dijkstra from the base station, cells are kept in the order they are settled
+    int *order = (int *)malloc(nbCells * sizeof(int));
+    int nbSettled = 0;
+    int neighbours[4];
+    t_heap heap = createHeap(nbCells);
+    t_position pos;
+    pos.x = base % map.x_max;
+    pos.y = base / map.x_max;
+    tree.costs[base] = 0;
+    pushHeap(&heap, pos, 0);
+    while (heap.nbElts > 0)
+    {
+        t_heap_node node = popHeap(&heap);
+        int u = node.pos.y * map.x_max + node.pos.x;
+        if (node.cost != tree.costs[u])
+        {
+            continue;
+        }
+        order[nbSettled++] = u;
+        int nb = getOpenNeighbours(map, u, neighbours);
+        for (int n = 0; n < nb; n++)
+        {
+            int v = neighbours[n];
+            int cost = node.cost + getSoilCost(map.soil_costs, map.soils[v / map.x_max][v % map.x_max]);
+            if (cost < tree.costs[v])
+            {
+                tree.costs[v] = cost;
+                tree.parent[v] = u;
+                pos.x = v % map.x_max;
+                pos.y = v / map.x_max;
+                pushHeap(&heap, pos, cost);
+            }
+        }
+    }
+    free(heap.values);
+    tree.nbReachable = nbSettled;
+
+    // a parent is settled before its children : sizes are summed backwards, preorder slots are given forwards
+    for (int i = nbSettled - 1; i >= 0; i--)
+    {
+        tree.subtree[order[i]]++;
+        if (i > 0)
+        {
+            tree.subtree[tree.parent[order[i]]] += tree.subtree[order[i]];
+        }
+    }
+    int *next_slot = (int *)malloc(nbCells * sizeof(int));
+    tree.first[base] = 0;
+    next_slot[base] = 1;
+    tree.preorder[0] = base;
+    for (int i = 1; i < nbSettled; i++)
+    {
+        int u = order[i];
+        int p = tree.parent[u];
+        tree.first[u] = next_slot[p];
+        next_slot[p] += tree.subtree[u];
+        next_slot[u] = tree.first[u] + 1;
+        tree.preorder[tree.first[u]] = u;
+    }
+    free(next_slot);
+    free(order);
+    return tree;
+}
+
+void freeCostTree(t_cost_tree *p_tree)
+{
+    free(p_tree->costs);
+    free(p_tree->parent);
+    free(p_tree->subtree);
+    free(p_tree->first);
+    free(p_tree->preorder);
+    p_tree->costs = NULL;
+    p_tree->parent = NULL;
+    p_tree->subtree = NULL;
+    p_tree->first = NULL;
+    p_tree->preorder = NULL;
+    return;
+}
+
+int findCriticalCells(const t_cost_tree *p_tree, t_critical_cell *cells, int k, int maxRepairs, int *p_nbRepairs)
+{
+    int nbCandidates = p_tree->nbReachable - 1;
+    int nbCells = p_tree->map.x_max * p_tree->map.y_max;
+    int nb = 0;
+    int nbRepairs = 0;
+    if (nbCandidates <= 0 || k <= 0)
+    {
+        if (p_nbRepairs != NULL)
+        {
+            *p_nbRepairs = 0;
+        }
+        return 0;
+    }
+    // bounds of every reachable cell but the base station (first in preorder), largest first
+    t_critical_cell *bounds = (t_critical_cell *)malloc(nbCandidates * sizeof(t_critical_cell));
+    for (int i = 0; i < nbCandidates; i++)
+    {
+        bounds[i] = boundCriticalCell(p_tree, p_tree->preorder[i + 1]);
+    }
+    qsort(bounds, nbCandidates, sizeof(t_critical_cell), compareCriticalCells);
+
+    int *new_costs = (int *)malloc(nbCells * sizeof(int));
+    t_heap heap = createHeap(64);
+    for (int i = 0; i < nbCandidates; i++)
+    {
+        // the bounds left cannot beat the k-th cell found
+        if (nb == k && !isMoreCritical(&bounds[i], &cells[k - 1]))
+        {
+            break;
+        }
+        t_critical_cell result = bounds[i];
+        if (!result.exact && nbRepairs < maxRepairs)
+        {
+            result = repairCriticalCell(p_tree, result.pos.y * p_tree->map.x_max + result.pos.x, new_costs, &heap);
+            nbRepairs++;
+        }
+        // insertion in the sorted array of the k most critical cells
+        if (nb < k || isMoreCritical(&result, &cells[nb - 1]))
+        {
+            int j = (nb < k) ? nb++ : nb - 1;
+            while (j > 0 && isMoreCritical(&result, &cells[j - 1]))
+            {
+                cells[j] = cells[j - 1];
+                j--;
+            }
+            cells[j] = result;
+        }
+    }
+    free(heap.values);
+    free(new_costs);
+    free(bounds);
+    if (p_nbRepairs != NULL)
+    {
+        *p_nbRepairs = nbRepairs;
+    }
+    return nb;
+}
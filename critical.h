@@ -0,0 +1,68 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_CRITICAL_H
+#define UNTITLED1_CRITICAL_H
+
+#include "loc.h"
+#include "map.h"
+
+/**
+ * @brief Structure for the shortest-path tree of the costs of a map
+ * cells are indexed by y * x_max + x; the cost of a cell is its soil cost plus the cost of its parent,
+ * the cost of the base station is 0 and crevasses are never crossed : unlike the costs of the map, which go
+ * through crevasses when nothing else reaches a cell, so both agree only on the cells reached without crevasse
+ */
+typedef struct s_cost_tree
+{
+    t_map   map;
+    int     *costs;     // exact costs, COST_UNDEF for the cells that cannot reach the base station
+    int     *parent;    // next cell towards the base station, -1 for the base station and unreachable cells
+    int     *subtree;   // number of cells whose path goes through the cell, itself included
+    int     *first;     // position of the cell in preorder, its subtree is [first, first + subtree)
+    int     *preorder;  // reachable cells in depth-first order of the tree
+    int     nbReachable;
+} t_cost_tree;
+
+/**
+ * @brief Structure for the effect of a new crevasse on a cell
+ */
+typedef struct s_critical_cell
+{
+    t_position  pos;
+    int         subtree;        // cells whose path went through the cell, itself included
+    long long   impact;         // total increase of the costs of the other cells that still reach the base station
+    int         nbDisconnected; // cells that can no longer reach the base station
+    int         exact;          // 1 if computed by a repair, 0 if impact and nbDisconnected are upper bounds
+} t_critical_cell;
+
+/**
+ * @brief Function to build the shortest-path tree of a map (Dijkstra from the base station)
+ * @param map : the map
+ * @return the tree
+ */
+t_cost_tree createCostTree(t_map);
+
+/**
+ * @brief Function to free a shortest-path tree (the map is not freed)
+ * @param p_tree : pointer to the tree
+ * @return none
+ */
+void freeCostTree(t_cost_tree *);
+
+/**
+ * @brief Function to find the cells that would increase the costs the most if they became crevasses
+ * only the subtree of a cell can change : every cell gets an upper bound from a detour around it, in linear
+ * time, then cells are repaired (Dijkstra restricted to their subtree) by decreasing bound until no bound
+ * can enter the top k. Cells are ranked by disconnected cells, then by impact.
+ * @param p_tree : pointer to the shortest-path tree
+ * @param cells : array receiving the most critical cells, most critical first
+ * @param k : the capacity of the cells array
+ * @param maxRepairs : the maximal number of repairs, the cells left get their bounds
+ * @param p_nbRepairs : pointer receiving the number of repairs done (can be NULL)
+ * @return the number of cells written
+ */
+int findCriticalCells(const t_cost_tree *, t_critical_cell *, int, int, int *);
+
+#endif //UNTITLED1_CRITICAL_H
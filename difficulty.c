@@ -0,0 +1,333 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "difficulty.h"
+#include "draw.h"
+#include "moves.h"
+#include "planner.h"
+
+/**
+ * @brief Structure for the state of a value iteration
+ * state s = (y * x_max + x) * 4 + ori, so that the states of a row of the map are contiguous
+ */
+typedef struct s_value_iteration
+{
+    t_map   map;
+    int     nbChoose;
+    int     nbDraws;
+    t_move  (*draws)[PLAN_MAX_MOVES];   // moves of each draw, sorted
+    int     *sizes;                     // number of moves of each draw
+    double  *probabilities;             // normalised probability of each draw
+    int     *next;                      // next[s * NB_MOVE_TYPES + m] : state after move m, -1 if it is fatal
+    char    *terminal;                  // 1 for the states whose value is known : base station, crevasse, lost
+    const double *old_values;
+    double  *new_values;
+    double  *row_residuals;             // largest change of a value in each row
+} t_value_iteration;
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to get the smallest value reachable with an ordered subset of the unused moves of a draw
+ * @param p_vi : pointer to the value iteration
+ * @param draw : the moves of the draw, sorted
+ * @param nbMoves : the number of moves of the draw
+ * @param used : the moves already chosen
+ * @param state : the state after the moves already chosen
+ * @param depth : the number of moves already chosen
+ * @return the smallest value, HUGE_VAL if every sequence is fatal
+ */
+double bestSequenceValue(const t_value_iteration *, const t_move *, int, int *, int, int);
+
+/**
+ * @brief function to update the values of the states of a range of rows (body of parallelForRows)
+ * @param map : the map
+ * @param y_begin : the first row
+ * @param y_end : the row after the last one
+ * @param ctx : pointer to the value iteration
+ * @return none
+ */
+void updateDifficultyRows(t_map, int, int, void *);
+
+/**
+ * @brief function to find the states from which no sequence of moves reaches the base station
+ * @param p_vi : pointer to the value iteration, whose transitions are computed
+ * @param nbStates : the number of states
+ * @return array of flags, 1 for the states that cannot reach the base station
+ */
+char *findLostStates(const t_value_iteration *, int);
+
+/* definition of local functions */
+
+double bestSequenceValue(const t_value_iteration *p_vi, const t_move *draw, int nbMoves, int *used, int state, int depth)
+{
+    double best = HUGE_VAL;
+    for (int i = 0; i < nbMoves; i++)
+    {
+        // equal moves are interchangeable : only the first unused one is tried at a given depth
+        if (used[i] || (i > 0 && draw[i] == draw[i - 1] && !used[i - 1]))
+        {
+            continue;
+        }
+        int next = p_vi->next[state * NB_MOVE_TYPES + draw[i]];
+        if (next < 0)
+        {
+            continue;
+        }
+        double value = p_vi->old_values[next];
+        if (value < best)
+        {
+            best = value;
+        }
+        // no sequence does better than reaching the base station, where the mission ends
+        if (p_vi->terminal[next])
+        {
+            if (value == 0.0)
+            {
+                return 0.0;
+            }
+            continue;
+        }
+        if (depth + 1 < p_vi->nbChoose)
+        {
+            used[i] = 1;
+            value = bestSequenceValue(p_vi, draw, nbMoves, used, next, depth + 1);
+            used[i] = 0;
+            if (value < best)
+            {
+                best = value;
+            }
+        }
+    }
+    return best;
+}
+
+void updateDifficultyRows(t_map map, int y_begin, int y_end, void *ctx)
+{
+    t_value_iteration *p_vi = (t_value_iteration *)ctx;
+    int used[PLAN_MAX_MOVES] = {0};
+    for (int y = y_begin; y < y_end; y++)
+    {
+        double residual = 0.0;
+        for (int s = y * map.x_max * 4; s < (y + 1) * map.x_max * 4; s++)
+        {
+            double value = p_vi->old_values[s];
+            if (!p_vi->terminal[s])
+            {
+                // one phase, then the expected value of the best sequence of each draw
+                value = 1.0;
+                for (int d = 0; d < p_vi->nbDraws; d++)
+                {
+                    double best = bestSequenceValue(p_vi, p_vi->draws[d], p_vi->sizes[d], used, s, 0);
+                    value += p_vi->probabilities[d] * ((best < DIFFICULTY_MAX_PHASES) ? best : DIFFICULTY_MAX_PHASES);
+                }
+                if (value > DIFFICULTY_MAX_PHASES)
+                {
+                    value = DIFFICULTY_MAX_PHASES;
+                }
+            }
+            p_vi->new_values[s] = value;
+            if (fabs(value - p_vi->old_values[s]) > residual)
+            {
+                residual = fabs(value - p_vi->old_values[s]);
+            }
+        }
+        p_vi->row_residuals[y] = residual;
+    }
+    return;
+}
+
+char *findLostStates(const t_value_iteration *p_vi, int nbStates)
+{
+    // predecessors of each state, grouped by state (counting sort of the transitions)
+    int nbEdges = nbStates * NB_MOVE_TYPES;
+    int *first = (int *)calloc(nbStates + 1, sizeof(int));
+    int *previous = (int *)malloc(nbEdges * sizeof(int));
+    for (int e = 0; e < nbEdges; e++)
+    {
+        if (p_vi->next[e] >= 0)
+        {
+            first[p_vi->next[e] + 1]++;
+        }
+    }
+    for (int s = 0; s < nbStates; s++)
+    {
+        first[s + 1] += first[s];
+    }
+    int *fill = (int *)malloc(nbStates * sizeof(int));
+    memcpy(fill, first, nbStates * sizeof(int));
+    for (int e = 0; e < nbEdges; e++)
+    {
+        if (p_vi->next[e] >= 0)
+        {
+            previous[fill[p_vi->next[e]]++] = e / NB_MOVE_TYPES;
+        }
+    }
+    free(fill);
+
+    // backward search from the base station, the states found are not lost
+    char *lost = (char *)malloc(nbStates);
+    int *stack = (int *)malloc(nbStates * sizeof(int));
+    int nbStacked = 0;
+    for (int s = 0; s < nbStates; s++)
+    {
+        int cell = s / 4;
+        lost[s] = (p_vi->map.soils[cell / p_vi->map.x_max][cell % p_vi->map.x_max] != BASE_STATION);
+        if (!lost[s])
+        {
+            stack[nbStacked++] = s;
+        }
+    }
+    while (nbStacked > 0)
+    {
+        int s = stack[--nbStacked];
+        for (int i = first[s]; i < first[s + 1]; i++)
+        {
+            if (lost[previous[i]])
+            {
+                lost[previous[i]] = 0;
+                stack[nbStacked++] = previous[i];
+            }
+        }
+    }
+    free(stack);
+    free(first);
+    free(previous);
+    return lost;
+}
+
+/* definitions of exported functions */
+
+t_difficulty computeDifficulty(t_map map, t_pool *p_pool, int nbDraw, int nbChoose, int maxDraws, double epsilon,
+                               int maxIterations)
+{
+    assert(nbDraw > 0 && nbDraw <= PLAN_MAX_MOVES && nbChoose > 0 && maxDraws > 0);
+    t_value_iteration vi;
+    int nbStates = map.x_max * map.y_max * 4;
+    vi.map = map;
+    vi.nbChoose = (nbChoose < nbDraw) ? nbChoose : nbDraw;
+
+    // distribution of the draws, restricted to the most probable ones
+    t_draw_key *keys = (t_draw_key *)malloc(maxDraws * sizeof(t_draw_key));
+    vi.nbDraws = getMostProbableDraws(nbDraw, keys, maxDraws);
+    vi.draws = malloc(vi.nbDraws * sizeof(*vi.draws));
+    vi.sizes = (int *)malloc(vi.nbDraws * sizeof(int));
+    vi.probabilities = (double *)malloc(vi.nbDraws * sizeof(double));
+    double mass = 0.0;
+    for (int d = 0; d < vi.nbDraws; d++)
+    {
+        vi.sizes[d] = getDrawFromKey(keys[d], vi.draws[d]);
+        vi.probabilities[d] = getDrawProbability(keys[d]);
+        mass += vi.probabilities[d];
+    }
+    for (int d = 0; d < vi.nbDraws; d++)
+    {
+        vi.probabilities[d] /= mass;
+    }
+    free(keys);
+
+    // transitions of move(), computed once for all the iterations
+    double *values = (double *)malloc(nbStates * sizeof(double));
+    double *new_values = (double *)malloc(nbStates * sizeof(double));
+    vi.next = (int *)malloc(nbStates * NB_MOVE_TYPES * sizeof(int));
+    vi.terminal = (char *)malloc(nbStates);
+    vi.row_residuals = (double *)malloc(map.y_max * sizeof(double));
+    for (int s = 0; s < nbStates; s++)
+    {
+        int cell = s / 4;
+        t_localisation loc = loc_init(cell % map.x_max, cell / map.x_max, s % 4);
+        t_soil soil = map.soils[loc.pos.y][loc.pos.x];
+        vi.terminal[s] = (soil == BASE_STATION || soil == CREVASSE);
+        values[s] = (soil == CREVASSE) ? DIFFICULTY_MAX_PHASES : 0.0;
+        for (int m = 0; m < NB_MOVE_TYPES; m++)
+        {
+            t_localisation next = move(loc, m);
+            if (!isValidLocalisation(next.pos, map.x_max, map.y_max) || map.soils[next.pos.y][next.pos.x] == CREVASSE)
+            {
+                vi.next[s * NB_MOVE_TYPES + m] = -1;
+            }
+            else
+            {
+                vi.next[s * NB_MOVE_TYPES + m] = (next.pos.y * map.x_max + next.pos.x) * 4 + next.ori;
+            }
+        }
+    }
+
+    // the states that cannot reach the base station are at the bound from the start, instead of reaching it
+    // one phase per iteration; the other values start from 0 and increase towards the fixed point
+    char *lost = findLostStates(&vi, nbStates);
+    for (int s = 0; s < nbStates; s++)
+    {
+        if (lost[s])
+        {
+            vi.terminal[s] = 1;
+            values[s] = DIFFICULTY_MAX_PHASES;
+        }
+    }
+    free(lost);
+    t_difficulty difficulty;
+    difficulty.x_max = map.x_max;
+    difficulty.y_max = map.y_max;
+    difficulty.nbIterations = 0;
+    difficulty.residual = HUGE_VAL;
+    difficulty.converged = 0;
+    while (difficulty.nbIterations < maxIterations && !difficulty.converged)
+    {
+        vi.old_values = values;
+        vi.new_values = new_values;
+        parallelForRows(p_pool, map, 0, updateDifficultyRows, &vi);
+        difficulty.residual = 0.0;
+        for (int y = 0; y < map.y_max; y++)
+        {
+            if (vi.row_residuals[y] > difficulty.residual)
+            {
+                difficulty.residual = vi.row_residuals[y];
+            }
+        }
+        double *tmp = values;
+        values = new_values;
+        new_values = tmp;
+        difficulty.nbIterations++;
+        difficulty.converged = (difficulty.residual < epsilon);
+    }
+
+    for (int ori = 0; ori < 4; ori++)
+    {
+        difficulty.planes[ori] = (double *)malloc(map.x_max * map.y_max * sizeof(double));
+        for (int cell = 0; cell < map.x_max * map.y_max; cell++)
+        {
+            difficulty.planes[ori][cell] = values[cell * 4 + ori];
+        }
+    }
+    free(values);
+    free(new_values);
+    free(vi.next);
+    free(vi.terminal);
+    free(vi.row_residuals);
+    free(vi.draws);
+    free(vi.sizes);
+    free(vi.probabilities);
+    return difficulty;
+}
+
+double getDifficulty(t_difficulty difficulty, t_localisation loc)
+{
+    assert(isValidLocalisation(loc.pos, difficulty.x_max, difficulty.y_max));
+    return difficulty.planes[loc.ori][loc.pos.y * difficulty.x_max + loc.pos.x];
+}
+
+void freeDifficulty(t_difficulty *p_difficulty)
+{
+    for (int ori = 0; ori < 4; ori++)
+    {
+        free(p_difficulty->planes[ori]);
+        p_difficulty->planes[ori] = NULL;
+    }
+    return;
+}
@@ -0,0 +1,63 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_DIFFICULTY_H
+#define UNTITLED1_DIFFICULTY_H
+
+#include "loc.h"
+#include "map.h"
+#include "pool.h"
+
+/**
+ * @brief Expected number of phases given to a lost mission (a draw without safe sequence), and upper bound of the values
+ */
+#define DIFFICULTY_MAX_PHASES 255.0
+
+/**
+ * @brief Structure for the difficulty of a map : the expected number of phases to reach the base station
+ * from every start localisation, when each phase draws moves at random and plays the best sequence of them
+ */
+typedef struct s_difficulty
+{
+    int     x_max;
+    int     y_max;
+    double  *planes[4];     // planes[ori][y * x_max + x], one plane per orientation
+    int     nbIterations;
+    double  residual;       // largest change of a value during the last iteration
+    int     converged;      // 1 if the residual went below the tolerance
+} t_difficulty;
+
+/**
+ * @brief Function to compute the difficulty of a map by value iteration
+ * a phase draws nbDraw moves and plays the ordered subset of at most nbChoose of them (simulated with move())
+ * that leads to the smallest expected number of phases left; only the maxDraws most probable draws are
+ * considered, their probabilities being normalised. Each iteration updates all the states from the values of
+ * the previous one (Jacobi), the rows of the map being split between the workers of the pool.
+ * @param map : the map
+ * @param p_pool : pointer to the pool
+ * @param nbDraw : the number of moves drawn per phase (at most PLAN_MAX_MOVES)
+ * @param nbChoose : the maximal number of moves chosen per phase
+ * @param maxDraws : the maximal number of distinct draws considered
+ * @param epsilon : the tolerance on the largest change of a value
+ * @param maxIterations : the maximal number of iterations
+ * @return the difficulty
+ */
+t_difficulty computeDifficulty(t_map, t_pool *, int, int, int, double, int);
+
+/**
+ * @brief Function to get the difficulty of a start localisation
+ * @param difficulty : the difficulty of the map
+ * @param loc : the localisation
+ * @return the expected number of phases to reach the base station
+ */
+double getDifficulty(t_difficulty, t_localisation);
+
+/**
+ * @brief Function to free the planes of a difficulty
+ * @param p_difficulty : pointer to the difficulty
+ * @return none
+ */
+void freeDifficulty(t_difficulty *);
+
+#endif //UNTITLED1_DIFFICULTY_H
@@ -0,0 +1,195 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include "draw.h"
+
+/**
+ * @brief Structure for a draw and its probability, used to rank draws
+ */
+typedef struct s_ranked_draw
+{
+    t_draw_key  key;
+    double      probability;
+} t_ranked_draw;
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to get the count of a move in a draw key
+ * @param key : the key of the draw
+ * @param move : the move
+ * @return the number of times the move was drawn
+ */
+int getDrawCount(t_draw_key, t_move);
+
+/**
+ * @brief qsort comparison of ranked draws, by decreasing probability then increasing key
+ * @param a : pointer to the first ranked draw
+ * @param b : pointer to the second ranked draw
+ * @return the comparison result
+ */
+int compareRankedDraws(const void *, const void *);
+
+/**
+ * @brief recursive enumeration of the multisets of moves of a given size
+ * @param move : the move whose count is chosen at this level
+ * @param nbLeft : the number of moves still to place
+ * @param key : the key built so far
+ * @param draws : array receiving the draws
+ * @param p_nb : pointer to the number of draws written
+ * @return none
+ */
+void enumerateDraws(int, int, t_draw_key, t_ranked_draw *, int *);
+
+/* definition of local functions */
+
+int getDrawCount(t_draw_key key, t_move move)
+{
+    return (key >> (4 * move)) & 0xF;
+}
+
+int compareRankedDraws(const void *a, const void *b)
+{
+    const t_ranked_draw *da = (const t_ranked_draw *)a;
+    const t_ranked_draw *db = (const t_ranked_draw *)b;
+    if (da->probability != db->probability)
+    {
+        return (da->probability > db->probability) ? -1 : 1;
+    }
+    return (da->key < db->key) ? -1 : (da->key > db->key);
+}
+
+void enumerateDraws(int move, int nbLeft, t_draw_key key, t_ranked_draw *draws, int *p_nb)
+{
+    if (move == NB_MOVE_TYPES - 1)
+    {
+        // the last move type takes all the remaining moves
+        key |= (t_draw_key)nbLeft << (4 * move);
+        draws[*p_nb].key = key;
+        draws[*p_nb].probability = getDrawProbability(key);
+        (*p_nb)++;
+        return;
+    }
+    for (int count = 0; count <= nbLeft; count++)
+    {
+        enumerateDraws(move + 1, nbLeft - count, key | ((t_draw_key)count << (4 * move)), draws, p_nb);
+    }
+    return;
+}
+
+/* definitions of exported functions */
+
+t_rng createRng(uint64_t seed, uint64_t stream)
+{
+    t_rng rng;
+    // the seed is scrambled before the stream is mixed in, so that nearby (seed, stream) pairs do not collide
+    rng.state = seed;
+    rng.state = nextRandom(&rng) ^ (stream * 0xD1B54A32D192ED03ull);
+    nextRandom(&rng);
+    return rng;
+}
+
+uint64_t nextRandom(t_rng *p_rng)
+{
+    uint64_t z = (p_rng->state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+int randomBelow(t_rng *p_rng, int n)
+{
+    assert(n > 0);
+    // multiply-shift : no division and a negligible bias for small n
+    return (int)(((nextRandom(p_rng) >> 32) * (uint64_t)n) >> 32);
+}
+
+void drawMoves(t_rng *p_rng, t_move *draw, int nbMoves)
+{
+    for (int i = 0; i < nbMoves; i++)
+    {
+        int r = randomBelow(p_rng, 100);
+        int m = 0;
+        while (r >= _move_weights[m])
+        {
+            r -= _move_weights[m];
+            m++;
+        }
+        draw[i] = m;
+    }
+    return;
+}
+
+t_draw_key getDrawKey(const t_move *draw, int nbMoves)
+{
+    t_draw_key key = 0;
+    for (int i = 0; i < nbMoves; i++)
+    {
+        // each count must fit in 4 bits
+        assert(getDrawCount(key, draw[i]) < 15);
+        key += (t_draw_key)1 << (4 * draw[i]);
+    }
+    return key;
+}
+
+int getDrawFromKey(t_draw_key key, t_move *draw)
+{
+    int nb = 0;
+    for (int m = 0; m < NB_MOVE_TYPES; m++)
+    {
+        for (int c = getDrawCount(key, m); c > 0; c--)
+        {
+            draw[nb++] = m;
+        }
+    }
+    return nb;
+}
+
+double getDrawProbability(t_draw_key key)
+{
+    // multinomial law : n! / (c_1! ... c_k!) * p_1^c_1 ... p_k^c_k
+    int n = 0;
+    double probability = 1.0;
+    for (int m = 0; m < NB_MOVE_TYPES; m++)
+    {
+        int count = getDrawCount(key, m);
+        for (int c = 1; c <= count; c++)
+        {
+            n++;
+            probability *= (double)n / c;
+        }
+        probability *= pow(_move_weights[m] / 100.0, count);
+    }
+    return probability;
+}
+
+int getMostProbableDraws(int nbMoves, t_draw_key *keys, int max)
+{
+    assert(nbMoves >= 0 && nbMoves < 15);
+    // there are C(nbMoves + 6, 6) multisets of nbMoves moves among 7
+    int nbDraws = 1;
+    for (int i = 1; i < NB_MOVE_TYPES; i++)
+    {
+        nbDraws = nbDraws * (nbMoves + i) / i;
+    }
+    t_ranked_draw *draws = (t_ranked_draw *)malloc(nbDraws * sizeof(t_ranked_draw));
+    int nb = 0;
+    enumerateDraws(0, nbMoves, 0, draws, &nb);
+    assert(nb == nbDraws);
+    qsort(draws, nb, sizeof(t_ranked_draw), compareRankedDraws);
+    if (nb > max)
+    {
+        nb = max;
+    }
+    for (int i = 0; i < nb; i++)
+    {
+        keys[i] = draws[i].key;
+    }
+    free(draws);
+    return nb;
+}
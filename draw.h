@@ -0,0 +1,94 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_DRAW_H
+#define UNTITLED1_DRAW_H
+
+#include <stdint.h>
+#include "moves.h"
+
+/**
+ * @brief Array of weights (out of 100) of the moves in a draw, indexed by t_move
+ */
+static const int _move_weights[NB_MOVE_TYPES] = {22, 15, 7, 7, 21, 21, 7};
+
+/**
+ * @brief Type for a draw seen as a multiset of moves : 4 bits per move type holding its count
+ */
+typedef unsigned int t_draw_key;
+
+/**
+ * @brief Structure for a pseudo-random generator (splitmix64), cheap to seed per mission and per phase
+ */
+typedef struct s_rng
+{
+    uint64_t state;
+} t_rng;
+
+/**
+ * @brief Function to create a generator for a stream of a seed
+ * streams of a seed are independent, e.g. one stream per phase of a mission
+ * @param seed : the seed
+ * @param stream : the stream
+ * @return the generator
+ */
+t_rng createRng(uint64_t, uint64_t);
+
+/**
+ * @brief Function to get the next 64 random bits of a generator
+ * @param p_rng : pointer to the generator
+ * @return the random bits
+ */
+uint64_t nextRandom(t_rng *);
+
+/**
+ * @brief Function to get a random integer in [0, n)
+ * @param p_rng : pointer to the generator
+ * @param n : the upper bound
+ * @return the random integer
+ */
+int randomBelow(t_rng *, int);
+
+/**
+ * @brief Function to draw moves independently with _move_weights
+ * @param p_rng : pointer to the generator
+ * @param draw : array receiving the moves
+ * @param nbMoves : the number of moves to draw
+ * @return none
+ */
+void drawMoves(t_rng *, t_move *, int);
+
+/**
+ * @brief Function to get the key of a draw (the order of the moves is ignored)
+ * @param draw : the moves drawn
+ * @param nbMoves : the number of moves drawn (at most 15 of each type)
+ * @return the key of the draw
+ */
+t_draw_key getDrawKey(const t_move *, int);
+
+/**
+ * @brief Function to expand a draw key into its moves, sorted by move
+ * @param key : the key of the draw
+ * @param draw : array receiving the moves
+ * @return the number of moves written
+ */
+int getDrawFromKey(t_draw_key, t_move *);
+
+/**
+ * @brief Function to get the probability of a draw, moves being drawn independently with _move_weights
+ * @param key : the key of the draw
+ * @return the probability of the multiset
+ */
+double getDrawProbability(t_draw_key);
+
+/**
+ * @brief Function to get the most probable draws of a given size
+ * @param nbMoves : the size of the draws
+ * @param keys : array receiving the keys, most probable first
+ * @param max : the capacity of the keys array
+ * @return the number of keys written
+ */
+int getMostProbableDraws(int, t_draw_key *, int);
+
+#endif //UNTITLED1_DRAW_H
@@ -0,0 +1,173 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include "estimate.h"
+
+/**
+ * @brief Structure for a batch of missions run by a task, with its own accumulators
+ */
+typedef struct s_mission_batch
+{
+    const t_mission_config  *config;
+    uint64_t                seed_begin;
+    uint64_t                seed_end;
+    t_running_stats         metrics[NB_METRICS];
+} t_mission_batch;
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to run the missions of a batch (task of the pool)
+ * @param arg : pointer to the batch
+ * @return none
+ */
+void runMissionBatch(void *);
+
+/**
+ * @brief function to check a stopping rule on the metrics estimated so far
+ * @param p_estimate : pointer to the estimate
+ * @param p_rule : pointer to the rule
+ * @return 1 if every requested half-width is reached, 0 otherwise
+ */
+int isEstimateConverged(const t_estimate *, const t_stopping_rule *);
+
+/* definition of local functions */
+
+void runMissionBatch(void *arg)
+{
+    t_mission_batch *p_batch = (t_mission_batch *)arg;
+    for (int m = 0; m < NB_METRICS; m++)
+    {
+        p_batch->metrics[m].n = 0;
+        p_batch->metrics[m].mean = 0.0;
+        p_batch->metrics[m].m2 = 0.0;
+    }
+    for (uint64_t seed = p_batch->seed_begin; seed < p_batch->seed_end; seed++)
+    {
+        t_mission_record record = simulateMission(p_batch->config, seed);
+        addToRunningStats(&p_batch->metrics[METRIC_SUCCESS], record.outcome == OUTCOME_BASE);
+        addToRunningStats(&p_batch->metrics[METRIC_PHASES], record.nbPhases);
+        if (record.outcome == OUTCOME_BASE || record.outcome == OUTCOME_TIMEOUT)
+        {
+            addToRunningStats(&p_batch->metrics[METRIC_COST], record.finalCost);
+        }
+    }
+    return;
+}
+
+int isEstimateConverged(const t_estimate *p_estimate, const t_stopping_rule *p_rule)
+{
+    if (p_estimate->nbMissions < p_rule->minMissions)
+    {
+        return 0;
+    }
+    for (int m = 0; m < NB_METRICS; m++)
+    {
+        if (p_rule->halfWidth[m] > 0.0 && getHalfWidth(p_estimate->metrics[m], p_rule->z) > p_rule->halfWidth[m])
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* definitions of exported functions */
+
+void addToRunningStats(t_running_stats *p_stats, double value)
+{
+    p_stats->n++;
+    double delta = value - p_stats->mean;
+    p_stats->mean += delta / p_stats->n;
+    p_stats->m2 += delta * (value - p_stats->mean);
+    return;
+}
+
+void mergeRunningStats(t_running_stats *p_stats, const t_running_stats *p_other)
+{
+    if (p_other->n == 0)
+    {
+        return;
+    }
+    uint64_t n = p_stats->n + p_other->n;
+    double delta = p_other->mean - p_stats->mean;
+    p_stats->mean += delta * p_other->n / n;
+    p_stats->m2 += p_other->m2 + delta * delta * ((double)p_stats->n * p_other->n / n);
+    p_stats->n = n;
+    return;
+}
+
+double getHalfWidth(t_running_stats stats, double z)
+{
+    if (stats.n < 2)
+    {
+        return HUGE_VAL;
+    }
+    // standard error of the mean, with the unbiased variance
+    return z * sqrt(stats.m2 / (stats.n - 1) / stats.n);
+}
+
+t_stopping_rule createStoppingRule(uint64_t budget)
+{
+    t_stopping_rule rule;
+    rule.z = 1.96;
+    for (int m = 0; m < NB_METRICS; m++)
+    {
+        rule.halfWidth[m] = 0.0;
+    }
+    rule.minMissions = 1000;
+    rule.budget = budget;
+    rule.batchSize = 256;
+    return rule;
+}
+
+t_estimate estimateMissions(const t_mission_config *p_config, t_pool *p_pool, uint64_t seed_begin, t_stopping_rule rule)
+{
+    assert(rule.batchSize > 0);
+    t_estimate estimate;
+    for (int m = 0; m < NB_METRICS; m++)
+    {
+        estimate.metrics[m].n = 0;
+        estimate.metrics[m].mean = 0.0;
+        estimate.metrics[m].m2 = 0.0;
+    }
+    estimate.nbMissions = 0;
+    estimate.converged = 0;
+
+    t_mission_batch batches[ESTIMATE_ROUND_BATCHES];
+    t_task_group group;
+    initTaskGroup(&group);
+    while (!estimate.converged && estimate.nbMissions < rule.budget)
+    {
+        // a round never goes beyond the budget
+        uint64_t seed = seed_begin + estimate.nbMissions;
+        uint64_t seed_end = seed_begin + rule.budget;
+        int nbBatches = 0;
+        while (nbBatches < ESTIMATE_ROUND_BATCHES && seed < seed_end)
+        {
+            batches[nbBatches].config = p_config;
+            batches[nbBatches].seed_begin = seed;
+            seed = (seed_end - seed > (uint64_t)rule.batchSize) ? seed + rule.batchSize : seed_end;
+            batches[nbBatches].seed_end = seed;
+            submitTask(p_pool, &group, runMissionBatch, &batches[nbBatches]);
+            nbBatches++;
+        }
+        waitTaskGroup(p_pool, &group);
+        for (int b = 0; b < nbBatches; b++)
+        {
+            for (int m = 0; m < NB_METRICS; m++)
+            {
+                mergeRunningStats(&estimate.metrics[m], &batches[b].metrics[m]);
+            }
+        }
+        estimate.nbMissions = seed - seed_begin;
+        estimate.converged = isEstimateConverged(&estimate, &rule);
+    }
+    destroyTaskGroup(&group);
+    estimate.saved = rule.budget - estimate.nbMissions;
+    return estimate;
+}
@@ -0,0 +1,105 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_ESTIMATE_H
+#define UNTITLED1_ESTIMATE_H
+
+#include <stdint.h>
+#include "mission.h"
+#include "pool.h"
+
+/**
+ * @brief Number of batches of missions run between two checks of the stopping rule
+ */
+#define ESTIMATE_ROUND_BATCHES 16
+
+/**
+ * @brief Enum for the metrics estimated over missions
+ */
+typedef enum e_metric
+{
+    METRIC_SUCCESS,     // 1 if the base station was reached, 0 otherwise
+    METRIC_PHASES,      // number of phases of the mission
+    METRIC_COST,        // final cost, for the missions that did not fall or leave the map
+    NB_METRICS
+} t_metric;
+
+/**
+ * @brief Structure for the running mean and variance of a sample (Welford), mergeable (Chan et al.)
+ */
+typedef struct s_running_stats
+{
+    uint64_t    n;
+    double      mean;
+    double      m2;     // sum of the squared deviations from the mean
+} t_running_stats;
+
+/**
+ * @brief Structure for the rule deciding when enough missions were run
+ */
+typedef struct s_stopping_rule
+{
+    double      z;                          // quantile of the confidence level, 1.96 for 95%
+    double      halfWidth[NB_METRICS];      // requested half-width of each interval, 0 for a metric without target
+    uint64_t    minMissions;                // missions run before the rule is checked
+    uint64_t    budget;                     // missions of a fixed-size campaign, the maximum run
+    int         batchSize;                  // missions per task
+} t_stopping_rule;
+
+/**
+ * @brief Structure for the estimate of the metrics of missions
+ */
+typedef struct s_estimate
+{
+    t_running_stats metrics[NB_METRICS];
+    uint64_t        nbMissions;
+    uint64_t        saved;      // missions of the budget that were not run
+    int             converged;  // 1 if every requested half-width was reached
+} t_estimate;
+
+/**
+ * @brief Function to add a value to running statistics
+ * @param p_stats : pointer to the statistics
+ * @param value : the value
+ * @return none
+ */
+void addToRunningStats(t_running_stats *, double);
+
+/**
+ * @brief Function to merge running statistics into others
+ * @param p_stats : pointer to the statistics receiving the merge
+ * @param p_other : pointer to the statistics to merge
+ * @return none
+ */
+void mergeRunningStats(t_running_stats *, const t_running_stats *);
+
+/**
+ * @brief Function to get the half-width of the confidence interval of the mean
+ * @param stats : the statistics
+ * @param z : the quantile of the confidence level
+ * @return the half-width, HUGE_VAL with less than 2 values
+ */
+double getHalfWidth(t_running_stats, double);
+
+/**
+ * @brief Function to create a stopping rule at 95% with no target
+ * @param budget : the missions of a fixed-size campaign
+ * @return the rule
+ */
+t_stopping_rule createStoppingRule(uint64_t);
+
+/**
+ * @brief Function to run missions from consecutive seeds until the stopping rule is met or the budget is spent
+ * batches of missions run on the pool, each in its own accumulators, and are merged in seed order after each
+ * round : the estimate does not depend on the number of workers. The strategy must be safe to call from
+ * several threads.
+ * @param p_config : pointer to the parameters of the missions
+ * @param p_pool : pointer to the pool
+ * @param seed_begin : the first seed
+ * @param rule : the stopping rule
+ * @return the estimate
+ */
+t_estimate estimateMissions(const t_mission_config *, t_pool *, uint64_t, t_stopping_rule);
+
+#endif //UNTITLED1_ESTIMATE_H
@@ -0,0 +1,205 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "field.h"
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to get the index in the window of a position of the map
+ * @param p_field : pointer to the local field
+ * @param pos : the position in the map
+ * @return the index, -1 if the position is outside the window
+ */
+int getLocalIndex(const t_local_field *, t_position);
+
+/**
+ * @brief function to relax the neighbours of a cell whose cost is final
+ * @param p_field : pointer to the local field
+ * @param map : the map
+ * @param pos : the position of the cell
+ * @param cost : the cost of the cell
+ * @param maxCost : the largest cost computed
+ * @param nbBuckets : the number of buckets, 0 to use the heap
+ * @return the number of cells queued
+ */
+int relaxLocalNeighbours(t_local_field *, t_map, t_position, int, int, int);
+
+/* definition of local functions */
+
+int getLocalIndex(const t_local_field *p_field, t_position pos)
+{
+    int x = pos.x - p_field->origin.x;
+    int y = pos.y - p_field->origin.y;
+    if (x < 0 || y < 0 || x >= p_field->side || y >= p_field->side)
+    {
+        return -1;
+    }
+    return y * p_field->side + x;
+}
+
+int relaxLocalNeighbours(t_local_field *p_field, t_map map, t_position pos, int cost, int maxCost, int nbBuckets)
+{
+    // left, right, up and down, computed here rather than with LEFT() ... DOWN() : this is the inner loop
+    static const int steps[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+    int nbQueued = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        t_position next;
+        next.x = pos.x + steps[i][0];
+        next.y = pos.y + steps[i][1];
+        int cell = getLocalIndex(p_field, next);
+        if (cell < 0 || next.x < 0 || next.y < 0 || next.x >= map.x_max || next.y >= map.y_max
+            || map.soils[next.y][next.x] == CREVASSE)
+        {
+            continue;
+        }
+        int nextCost = cost + map.soil_costs->cost[map.soils[next.y][next.x]];
+        if (nextCost > maxCost || (p_field->stamps[cell] == p_field->epoch && nextCost >= p_field->costs[cell]))
+        {
+            continue;
+        }
+        p_field->costs[cell] = nextCost;
+        p_field->stamps[cell] = p_field->epoch;
+        nbQueued++;
+        if (nbBuckets == 0)
+        {
+            pushHeap(&p_field->heap, next, nextCost);
+            continue;
+        }
+        int b = nextCost % nbBuckets;
+        if (p_field->bucketSizes[b] == p_field->bucketCapacities[b])
+        {
+            p_field->bucketCapacities[b] = (p_field->bucketCapacities[b] > 0) ? 2 * p_field->bucketCapacities[b] : 64;
+            p_field->buckets[b] = (int *)realloc(p_field->buckets[b], p_field->bucketCapacities[b] * sizeof(int));
+        }
+        p_field->buckets[b][p_field->bucketSizes[b]++] = cell;
+    }
+    return nbQueued;
+}
+
+/* definitions of exported functions */
+
+t_local_field createLocalField(int radius)
+{
+    assert(radius >= 0);
+    t_local_field field;
+    field.radius = radius;
+    field.side = 2 * radius + 1;
+    field.origin.x = 0;
+    field.origin.y = 0;
+    field.costs = (int *)malloc(field.side * field.side * sizeof(int));
+    // stamps of 0 are never an epoch : no cell is reached before the first computation
+    field.stamps = (uint32_t *)calloc(field.side * field.side, sizeof(uint32_t));
+    field.epoch = 0;
+    field.heap = createHeap(4 * field.side);
+    for (int b = 0; b <= FIELD_MAX_BUCKETS; b++)
+    {
+        field.buckets[b] = NULL;
+        field.bucketSizes[b] = 0;
+        field.bucketCapacities[b] = 0;
+    }
+    field.nbReached = 0;
+    return field;
+}
+
+void freeLocalField(t_local_field *p_field)
+{
+    free(p_field->costs);
+    free(p_field->stamps);
+    free(p_field->heap.values);
+    for (int b = 0; b <= FIELD_MAX_BUCKETS; b++)
+    {
+        free(p_field->buckets[b]);
+        p_field->buckets[b] = NULL;
+    }
+    p_field->costs = NULL;
+    p_field->stamps = NULL;
+    p_field->heap.values = NULL;
+    return;
+}
+
+int computeLocalField(t_local_field *p_field, t_map map, t_localisation loc, int maxCost)
+{
+    assert(isValidLocalisation(loc.pos, map.x_max, map.y_max));
+    p_field->epoch++;
+    if (p_field->epoch == 0)
+    {
+        // after 2^32 computations, the stamps of old ones could be taken for the new one
+        memset(p_field->stamps, 0, p_field->side * p_field->side * sizeof(uint32_t));
+        p_field->epoch = 1;
+    }
+    p_field->origin.x = loc.pos.x - p_field->radius;
+    p_field->origin.y = loc.pos.y - p_field->radius;
+    p_field->nbReached = 0;
+    p_field->heap.nbElts = 0;
+
+    int start = getLocalIndex(p_field, loc.pos);
+    p_field->costs[start] = 0;
+    p_field->stamps[start] = p_field->epoch;
+    int maxSoilCost = 0;
+    for (int s = PLAIN; s < CREVASSE; s++)
+    {
+        maxSoilCost = (getSoilCost(map.soil_costs, s) > maxSoilCost) ? getSoilCost(map.soil_costs, s) : maxSoilCost;
+    }
+    if (maxSoilCost > FIELD_MAX_BUCKETS)
+    {
+        pushHeap(&p_field->heap, loc.pos, 0);
+        while (p_field->heap.nbElts > 0)
+        {
+            t_heap_node node = popHeap(&p_field->heap);
+            if (node.cost != p_field->costs[getLocalIndex(p_field, node.pos)])
+            {
+                continue;
+            }
+            p_field->nbReached++;
+            relaxLocalNeighbours(p_field, map, node.pos, node.cost, maxCost, 0);
+        }
+        return p_field->nbReached;
+    }
+    // a cell is queued with a cost at most maxSoilCost above the current one : maxSoilCost + 1 buckets never mix
+    // two costs, and the buckets are emptied by increasing cost
+    int nbBuckets = maxSoilCost + 1;
+    int nbQueued = 1;
+    p_field->buckets[0] = (p_field->buckets[0] != NULL) ? p_field->buckets[0] : (int *)malloc(64 * sizeof(int));
+    p_field->bucketCapacities[0] = (p_field->bucketCapacities[0] > 0) ? p_field->bucketCapacities[0] : 64;
+    p_field->buckets[0][0] = start;
+    p_field->bucketSizes[0] = 1;
+    for (int cost = 0; nbQueued > 0; cost++)
+    {
+        int b = cost % nbBuckets;
+        // a base station costs 0 : entering one appends its cell to this very bucket, to be handled in the same
+        // pass, and may realloc the bucket, so the size and the pointer of the bucket are re-read on each turn
+        for (int i = 0; i < p_field->bucketSizes[b]; i++)
+        {
+            int cell = p_field->buckets[b][i];
+            nbQueued--;
+            if (p_field->costs[cell] != cost)
+            {
+                continue;
+            }
+            p_field->nbReached++;
+            t_position pos;
+            pos.x = p_field->origin.x + cell % p_field->side;
+            pos.y = p_field->origin.y + cell / p_field->side;
+            nbQueued += relaxLocalNeighbours(p_field, map, pos, cost, maxCost, nbBuckets);
+        }
+        p_field->bucketSizes[b] = 0;
+    }
+    return p_field->nbReached;
+}
+
+int getLocalCost(const t_local_field *p_field, t_position pos)
+{
+    int cell = getLocalIndex(p_field, pos);
+    if (cell < 0 || p_field->stamps[cell] != p_field->epoch)
+    {
+        return COST_UNDEF;
+    }
+    return p_field->costs[cell];
+}
@@ -0,0 +1,74 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_FIELD_H
+#define UNTITLED1_FIELD_H
+
+#include <stdint.h>
+#include "heap.h"
+#include "loc.h"
+#include "map.h"
+
+/**
+ * @brief Largest soil cost for which a local field uses a bucket queue instead of the heap
+ */
+#define FIELD_MAX_BUCKETS 64
+
+/**
+ * @brief Structure for the costs around a robot, in a square window centred on it
+ * a cell of the window holds a cost only if its stamp is the epoch of the last computation :
+ * the buffers are reused from a call to the next without being cleared
+ */
+typedef struct s_local_field
+{
+    int         radius;     // the window spans radius cells on each side of the robot
+    int         side;       // 2 * radius + 1
+    t_position  origin;     // position in the map of the first cell of the window
+    int         *costs;     // side x side, row by row
+    uint32_t    *stamps;
+    uint32_t    epoch;
+    t_heap      heap;                           // queue of the soil costs above FIELD_MAX_BUCKETS
+    int         *buckets[FIELD_MAX_BUCKETS + 1];  // cells waiting for each cost modulo (largest soil cost + 1)
+    int         bucketSizes[FIELD_MAX_BUCKETS + 1];
+    int         bucketCapacities[FIELD_MAX_BUCKETS + 1];
+    int         nbReached;  // cells reached by the last computation
+} t_local_field;
+
+/**
+ * @brief Function to create the buffers of a local field
+ * @param radius : the largest distance (in cells, along each axis) from the robot to a cell of the field
+ * @return the local field
+ */
+t_local_field createLocalField(int);
+
+/**
+ * @brief Function to free a local field
+ * @param p_field : pointer to the local field
+ * @return none
+ */
+void freeLocalField(t_local_field *);
+
+/**
+ * @brief Function to compute the cost of reaching the cells around a robot
+ * a Dijkstra from the robot (cost 0) where entering a cell costs its soil, crevasses are never entered;
+ * it stops at the edge of the window and at the cost bound, so its time does not depend on the size of the map.
+ * Soil costs are small integers : the queue is a ring of buckets, one per cost, unless a soil costs more than
+ * FIELD_MAX_BUCKETS
+ * @param p_field : pointer to the local field
+ * @param map : the map
+ * @param loc : the localisation of the robot
+ * @param maxCost : the largest cost computed, the cells beyond are left unreached
+ * @return the number of cells reached
+ */
+int computeLocalField(t_local_field *, t_map, t_localisation, int);
+
+/**
+ * @brief Function to get the cost of a cell of the last computation of a local field
+ * @param p_field : pointer to the local field
+ * @param pos : the position of the cell in the map
+ * @return the cost, COST_UNDEF if the cell was not reached or is outside the window
+ */
+int getLocalCost(const t_local_field *, t_position);
+
+#endif //UNTITLED1_FIELD_H
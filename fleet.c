@@ -0,0 +1,210 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <assert.h>
+#include <string.h>
+#include "fleet.h"
+
+/**
+ * @brief Structure for the context of the filter of the robot being planned
+ */
+typedef struct s_fleet_filter
+{
+    const t_fleet   *fleet;
+    int             robot;
+} t_fleet_filter;
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to accept the cells not reserved by another robot (see t_plan_filter)
+ * @param ctx : pointer to the t_fleet_filter
+ * @return 1 if the robot may be there, 0 otherwise
+ */
+int isFreeForRobot(t_position, int, int, void *);
+
+/**
+ * @brief function to reserve the cells of a sequence of moves for a robot
+ * @param p_fleet : pointer to the fleet
+ * @param robot : the index of the robot
+ * @param loc : the localisation of the robot at the start of the phase
+ * @param moves : the moves
+ * @param nbMoves : the number of moves
+ * @return 1 if every cell could be reserved, 0 if one is held by another robot
+ */
+int reserveMoves(t_fleet *, int, t_localisation, const t_move *, int);
+
+/* definition of local functions */
+
+int isFreeForRobot(t_position pos, int step, int final, void *ctx)
+{
+    t_fleet_filter *p_filter = (t_fleet_filter *)ctx;
+    const t_fleet *p_fleet = p_filter->fleet;
+    if (p_fleet->planner->map.soils[pos.y][pos.x] == BASE_STATION)
+    {
+        return 1;
+    }
+    // a stop holds the cell until the end of the phase
+    int last = final ? p_fleet->nbChoose : step;
+    for (int s = step; s <= last; s++)
+    {
+        int robot = getCellReservation(&p_fleet->table, pos, s);
+        if (robot >= 0 && robot != p_filter->robot)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int reserveMoves(t_fleet *p_fleet, int robot, t_localisation loc, const t_move *moves, int nbMoves)
+{
+    const t_map *map = &p_fleet->planner->map;
+    int held = 1;
+    for (int i = 0; i < nbMoves; i++)
+    {
+        loc = move(loc, moves[i]);
+        if (!isValidLocalisation(loc.pos, map->x_max, map->y_max) || map->soils[loc.pos.y][loc.pos.x] == CREVASSE)
+        {
+            return held;
+        }
+        if (map->soils[loc.pos.y][loc.pos.x] == BASE_STATION)
+        {
+            return held;
+        }
+        int last = (i == nbMoves - 1) ? p_fleet->nbChoose : i + 1;
+        for (int s = i + 1; s <= last; s++)
+        {
+            held &= reserveCell(&p_fleet->table, loc.pos, s, robot);
+        }
+    }
+    return held;
+}
+
+/* definitions of exported functions */
+
+t_fleet createFleet(const t_planner *p_planner, int nbRobots, int nbDraw, int nbChoose, int maxPhases)
+{
+    assert(nbRobots > 0 && nbRobots <= FLEET_MAX_ROBOTS);
+    assert(nbDraw > 0 && nbDraw <= PLAN_MAX_MOVES);
+    assert(maxPhases > 0 && maxPhases <= MISSION_MAX_PHASES);
+    t_fleet fleet;
+    fleet.planner = p_planner;
+    fleet.nbRobots = nbRobots;
+    fleet.nbDraw = nbDraw;
+    fleet.nbChoose = (nbChoose < nbDraw) ? nbChoose : nbDraw;
+    fleet.maxPhases = maxPhases;
+    // at most one cell per robot and per step of a phase
+    fleet.table = createReservationTable(nbRobots * (PLAN_MAX_MOVES + 1));
+    return fleet;
+}
+
+void freeFleet(t_fleet *p_fleet)
+{
+    freeReservationTable(&p_fleet->table);
+    return;
+}
+
+int planFleetPhase(t_fleet *p_fleet, const t_localisation *locs, const int *active,
+                   const t_move (*draws)[PLAN_MAX_MOVES], t_plan *plans)
+{
+    int nbConflicts = 0;
+    clearReservations(&p_fleet->table);
+    for (int r = 0; r < p_fleet->nbRobots; r++)
+    {
+        if (active[r])
+        {
+            reserveCell(&p_fleet->table, locs[r].pos, 0, r);
+        }
+    }
+    // the robots are planned in order : each one plans around the cells held by the previous ones
+    for (int r = 0; r < p_fleet->nbRobots; r++)
+    {
+        if (!active[r])
+        {
+            continue;
+        }
+        t_fleet_filter filter;
+        filter.fleet = p_fleet;
+        filter.robot = r;
+        if (planTopKFiltered(p_fleet->planner, locs[r], draws[r], p_fleet->nbDraw, p_fleet->nbChoose, &plans[r], 1,
+                             isFreeForRobot, &filter) == 0)
+        {
+            // without a safe sequence the robot still has to move
+            plans[r].moves[0] = draws[r][0];
+            plans[r].nbMoves = 1;
+            plans[r].end = move(locs[r], draws[r][0]);
+            plans[r].cost = COST_UNDEF;
+        }
+        if (!reserveMoves(p_fleet, r, locs[r], plans[r].moves, plans[r].nbMoves))
+        {
+            nbConflicts++;
+        }
+    }
+    return nbConflicts;
+}
+
+int simulateFleetMission(t_fleet *p_fleet, uint64_t seed, t_mission_record *records)
+{
+    t_map map = p_fleet->planner->map;
+    t_localisation locs[FLEET_MAX_ROBOTS];
+    int active[FLEET_MAX_ROBOTS];
+    t_move draws[FLEET_MAX_ROBOTS][PLAN_MAX_MOVES];
+    t_plan plans[FLEET_MAX_ROBOTS];
+    int nbConflicts = 0, nbActive = 0;
+    for (int r = 0; r < p_fleet->nbRobots; r++)
+    {
+        locs[r] = drawStartLocalisation(map, seed * FLEET_MAX_ROBOTS + r);
+        records[r].seed = seed * FLEET_MAX_ROBOTS + r;
+        records[r].start = locs[r];
+        records[r].nbPhases = 0;
+        records[r].outcome = (map.soils[locs[r].pos.y][locs[r].pos.x] == BASE_STATION) ? OUTCOME_BASE : OUTCOME_TIMEOUT;
+        active[r] = (records[r].outcome == OUTCOME_TIMEOUT);
+        nbActive += active[r];
+    }
+    for (int phase = 0; phase < p_fleet->maxPhases && nbActive > 0; phase++)
+    {
+        for (int r = 0; r < p_fleet->nbRobots; r++)
+        {
+            drawPhaseMoves(records[r].seed, phase, draws[r], p_fleet->nbDraw);
+        }
+        nbConflicts += planFleetPhase(p_fleet, locs, active, (const t_move (*)[PLAN_MAX_MOVES])draws, plans);
+        for (int r = 0; r < p_fleet->nbRobots; r++)
+        {
+            if (!active[r])
+            {
+                continue;
+            }
+            records[r].nbPhases++;
+            for (int i = 0; i < plans[r].nbMoves && records[r].outcome == OUTCOME_TIMEOUT; i++)
+            {
+                updateLocalisation(&locs[r], plans[r].moves[i]);
+                if (!isValidLocalisation(locs[r].pos, map.x_max, map.y_max))
+                {
+                    records[r].outcome = OUTCOME_OUT;
+                }
+                else if (map.soils[locs[r].pos.y][locs[r].pos.x] == CREVASSE)
+                {
+                    records[r].outcome = OUTCOME_CREVASSE;
+                }
+                else if (map.soils[locs[r].pos.y][locs[r].pos.x] == BASE_STATION)
+                {
+                    records[r].outcome = OUTCOME_BASE;
+                }
+            }
+            // a robot at the base station, out of the map or in a crevasse leaves the fleet
+            if (records[r].outcome != OUTCOME_TIMEOUT)
+            {
+                active[r] = 0;
+                nbActive--;
+            }
+        }
+    }
+    for (int r = 0; r < p_fleet->nbRobots; r++)
+    {
+        records[r].finalCost = (records[r].outcome == OUTCOME_OUT) ? COST_UNDEF : map.costs[locs[r].pos.y][locs[r].pos.x];
+    }
+    return nbConflicts;
+}
@@ -0,0 +1,75 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_FLEET_H
+#define UNTITLED1_FLEET_H
+
+#include <stdint.h>
+#include "mission.h"
+#include "planner.h"
+#include "reservation.h"
+#include "results.h"
+
+/**
+ * @brief Maximal number of robots of a fleet
+ */
+#define FLEET_MAX_ROBOTS 64
+
+/**
+ * @brief Structure for the robots of a fleet sharing a map
+ * step 0 of a phase is the start of the phase, step i the cell after the i-th move; a robot that has done
+ * all its moves stays on its last cell until the end of the phase (step nbChoose)
+ */
+typedef struct s_fleet
+{
+    const t_planner     *planner;
+    t_reservation_table table;
+    int                 nbRobots;
+    int                 nbDraw;
+    int                 nbChoose;
+    int                 maxPhases;
+} t_fleet;
+
+/**
+ * @brief Function to create a fleet of robots planned with a planner
+ * @param p_planner : pointer to the planner
+ * @param nbRobots : the number of robots (at most FLEET_MAX_ROBOTS)
+ * @param nbDraw : the number of moves drawn per phase
+ * @param nbChoose : the number of moves chosen per phase
+ * @param maxPhases : the maximal number of phases (at most MISSION_MAX_PHASES)
+ * @return the fleet
+ */
+t_fleet createFleet(const t_planner *, int, int, int, int);
+
+/**
+ * @brief Function to free the reservation table of a fleet
+ * @param p_fleet : pointer to the fleet
+ * @return none
+ */
+void freeFleet(t_fleet *);
+
+/**
+ * @brief Function to plan a phase of the robots of a fleet, one after the other
+ * the cells of each robot are reserved at each step, the following robots only take plans whose cells are
+ * free at their steps (the base station is shared); a robot without such a plan does the first move drawn
+ * @param p_fleet : pointer to the fleet
+ * @param locs : the localisations of the robots
+ * @param active : 1 for each robot still on the map, 0 for the others (they are not planned)
+ * @param draws : the moves drawn for each robot
+ * @param plans : array receiving the plan of each active robot
+ * @return the number of robots whose moves may collide with the ones of a robot planned before
+ */
+int planFleetPhase(t_fleet *, const t_localisation *, const int *, const t_move (*)[PLAN_MAX_MOVES], t_plan *);
+
+/**
+ * @brief Function to simulate a mission of every robot of a fleet on the same map
+ * robot r draws its start and its moves from the seed seed * FLEET_MAX_ROBOTS + r (see simulateMission)
+ * @param p_fleet : pointer to the fleet
+ * @param seed : the seed of the mission
+ * @param records : array receiving the record of each robot
+ * @return the number of robots whose moves may have collided during the mission
+ */
+int simulateFleetMission(t_fleet *, uint64_t, t_mission_record *);
+
+#endif //UNTITLED1_FLEET_H
@@ -0,0 +1,184 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+/* generator of the lookup tables used by moves.c and map.c
+ * it is run by the build and writes a header of const arrays, so that no table
+ * is built at startup and the compiler can fold the lookups
+ * usage : gen_tables <output header>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "loc.h"
+#include "map.h"
+#include "moves.h"
+
+#define NB_ORIENTATIONS 4
+#define NB_SOILS 5
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to get the number of quarter turns (clockwise) of a move
+ * @param move : the move
+ * @return the number of quarter turns
+ */
+int getMoveTurns(t_move);
+
+/**
+ * @brief function to get the signed number of cells a move goes forward
+ * @param move : the move
+ * @return the number of cells, negative for a backward move
+ */
+int getMoveSteps(t_move);
+
+/**
+ * @brief function to write a string as a C literal, escaping non printable characters
+ * @param file : the output file
+ * @param str : the string
+ * @return none
+ */
+void writeLiteral(FILE *, const char *);
+
+/* definition of local functions */
+
+int getMoveTurns(t_move move)
+{
+    switch (move)
+    {
+        case T_LEFT:
+            return 3;
+        case T_RIGHT:
+            return 1;
+        case U_TURN:
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+int getMoveSteps(t_move move)
+{
+    switch (move)
+    {
+        case F_10:
+            return 1;
+        case F_20:
+            return 2;
+        case F_30:
+            return 3;
+        case B_10:
+            return -1;
+        default:
+            return 0;
+    }
+}
+
+void writeLiteral(FILE *file, const char *str)
+{
+    fputc('"', file);
+    for (; *str; str++)
+    {
+        unsigned char c = (unsigned char)*str;
+        if (c < 32 || c > 126 || c == '"' || c == '\\')
+        {
+            fprintf(file, "\\%03o", c);
+        }
+        else
+        {
+            fputc(c, file);
+        }
+    }
+    fputc('"', file);
+    return;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s <output header>\n", argv[0]);
+        return 1;
+    }
+    FILE *file = fopen(argv[1], "wt");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Error: cannot open file %s\n", argv[1]);
+        return 1;
+    }
+    /** rules for coordinates (see moves.c):
+     *  - x grows to the right, y grows to the bottom
+     *  - unit vectors of the orientations : NORTH (0,-1), EAST (1,0), SOUTH (0,1), WEST (-1,0)
+     */
+    const int unit[NB_ORIENTATIONS][2] = {{0, -1}, {1, 0}, {0, 1}, {-1, 0}};
+
+    fprintf(file, "// generated by gen_tables.c - do not edit\n\n");
+    fprintf(file, "#ifndef UNTITLED1_TABLES_H\n#define UNTITLED1_TABLES_H\n\n");
+    fprintf(file, "#include \"loc.h\"\n\n");
+
+    fprintf(file, "/**\n * @brief Array of the orientations after a move, indexed by [orientation][move]\n */\n");
+    fprintf(file, "static const t_orientation _move_rotation[%d][%d] = {\n", NB_ORIENTATIONS, NB_MOVE_TYPES);
+    for (int ori = 0; ori < NB_ORIENTATIONS; ori++)
+    {
+        fprintf(file, "    {");
+        for (int m = 0; m < NB_MOVE_TYPES; m++)
+        {
+            fprintf(file, "%d%s", (ori + getMoveTurns(m)) % NB_ORIENTATIONS, (m < NB_MOVE_TYPES - 1) ? ", " : "");
+        }
+        fprintf(file, "}%s\n", (ori < NB_ORIENTATIONS - 1) ? "," : "");
+    }
+    fprintf(file, "};\n\n");
+
+    fprintf(file, "/**\n * @brief Array of the translations {dx, dy} of a move, indexed by [orientation][move]\n */\n");
+    fprintf(file, "static const int _move_delta[%d][%d][2] = {\n", NB_ORIENTATIONS, NB_MOVE_TYPES);
+    for (int ori = 0; ori < NB_ORIENTATIONS; ori++)
+    {
+        fprintf(file, "    {");
+        for (int m = 0; m < NB_MOVE_TYPES; m++)
+        {
+            int steps = getMoveSteps(m);
+            fprintf(file, "{%d, %d}%s", steps * unit[ori][0], steps * unit[ori][1], (m < NB_MOVE_TYPES - 1) ? ", " : "");
+        }
+        fprintf(file, "}%s\n", (ori < NB_ORIENTATIONS - 1) ? "," : "");
+    }
+    fprintf(file, "};\n\n");
+
+    fprintf(file, "/**\n * @brief Array of the number of cells covered by a move, indexed by move\n */\n");
+    fprintf(file, "static const int _move_reach[%d] = {", NB_MOVE_TYPES);
+    for (int m = 0; m < NB_MOVE_TYPES; m++)
+    {
+        fprintf(file, "%d%s", abs(getMoveSteps(m)), (m < NB_MOVE_TYPES - 1) ? ", " : "");
+    }
+    fprintf(file, "};\n\n");
+
+    /** the rules for display are (see map.c):
+     * display all soils with 3x3 characters
+     * characters are : B for base station, '-' for plain, '~' for erg, '^' for reg, 219 for crevasse
+     */
+    const char *glyphs[NB_SOILS][3] = {
+        {"   ", " B ", "   "},
+        {"---", "---", "---"},
+        {"~~~", "~~~", "~~~"},
+        {"^^^", "^^^", "^^^"},
+        {"\333\333\333", "\333\333\333", "\333\333\333"}
+    };
+    fprintf(file, "/**\n * @brief Array of the 3x3 characters displaying a soil, indexed by [soil][row]\n */\n");
+    fprintf(file, "static const char _soil_glyphs[%d][3][4] = {\n", NB_SOILS);
+    for (int s = 0; s < NB_SOILS; s++)
+    {
+        fprintf(file, "    {");
+        for (int rep = 0; rep < 3; rep++)
+        {
+            writeLiteral(file, glyphs[s][rep]);
+            fprintf(file, "%s", (rep < 2) ? ", " : "");
+        }
+        fprintf(file, "}%s\n", (s < NB_SOILS - 1) ? "," : "");
+    }
+    fprintf(file, "};\n\n");
+
+    fprintf(file, "#endif //UNTITLED1_TABLES_H\n");
+    fclose(file);
+    return 0;
+}
@@ -0,0 +1,96 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <assert.h>
+#include <stdlib.h>
+#include "heap.h"
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to compare two nodes of a heap
+ * @param a : the first node
+ * @param b : the second node
+ * @return 1 if a must be popped before b, 0 otherwise
+ */
+int isHeapNodeBefore(t_heap_node, t_heap_node);
+
+/* definition of local functions */
+
+int isHeapNodeBefore(t_heap_node a, t_heap_node b)
+{
+    if (a.cost != b.cost)
+    {
+        return a.cost < b.cost;
+    }
+    if (a.pos.y != b.pos.y)
+    {
+        return a.pos.y < b.pos.y;
+    }
+    return a.pos.x < b.pos.x;
+}
+
+/* definitions of exported functions */
+
+t_heap createHeap(int size)
+{
+    // the size of the heap must be positive
+    assert(size > 0);
+    t_heap heap;
+    heap.size = size;
+    heap.nbElts = 0;
+    heap.values = (t_heap_node *)malloc(size * sizeof(t_heap_node));
+    return heap;
+}
+
+void pushHeap(t_heap *p_heap, t_position pos, int cost)
+{
+    // the heap grows when it is full : a position can be pushed again when its cost decreases
+    if (p_heap->nbElts == p_heap->size)
+    {
+        p_heap->size *= 2;
+        p_heap->values = (t_heap_node *)realloc(p_heap->values, p_heap->size * sizeof(t_heap_node));
+    }
+    t_heap_node node;
+    node.pos = pos;
+    node.cost = cost;
+    int i = p_heap->nbElts++;
+    while (i > 0 && isHeapNodeBefore(node, p_heap->values[(i - 1) / 2]))
+    {
+        p_heap->values[i] = p_heap->values[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    p_heap->values[i] = node;
+    return;
+}
+
+t_heap_node popHeap(t_heap *p_heap)
+{
+    // the heap must not be empty
+    assert(p_heap->nbElts > 0);
+    t_heap_node root = p_heap->values[0];
+    t_heap_node last = p_heap->values[--p_heap->nbElts];
+    int i = 0;
+    while (1)
+    {
+        int child = 2 * i + 1;
+        if (child >= p_heap->nbElts)
+        {
+            break;
+        }
+        if (child + 1 < p_heap->nbElts && isHeapNodeBefore(p_heap->values[child + 1], p_heap->values[child]))
+        {
+            child++;
+        }
+        if (!isHeapNodeBefore(p_heap->values[child], last))
+        {
+            break;
+        }
+        p_heap->values[i] = p_heap->values[child];
+        i = child;
+    }
+    p_heap->values[i] = last;
+    return root;
+}
@@ -0,0 +1,51 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_HEAP_H
+#define UNTITLED1_HEAP_H
+#include "loc.h"
+
+/**
+ * @brief Structure for a position and its cost, element of the heap
+ */
+typedef struct s_heap_node
+{
+    t_position  pos;
+    int         cost;
+} t_heap_node;
+
+/**
+ * @brief Structure for the min-heap of positions, ordered by cost
+ */
+typedef struct s_heap
+{
+    t_heap_node *values;
+    int size;
+    int nbElts;
+} t_heap;
+
+/**
+ * @brief Function to create a heap
+ * @param size : the size of the heap
+ * @return the heap
+ */
+t_heap createHeap(int);
+
+/**
+ * @brief Function to push a position in the heap
+ * @param p_heap : pointer to the heap
+ * @param pos : the position
+ * @param cost : the cost of the position
+ * @return none
+ */
+void pushHeap(t_heap *, t_position, int);
+
+/**
+ * @brief Function to pop the position of smallest cost (ties are broken by row, then by column)
+ * @param p_heap : pointer to the heap
+ * @return the node popped
+ */
+t_heap_node popHeap(t_heap *);
+
+#endif //UNTITLED1_HEAP_H
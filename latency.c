@@ -0,0 +1,126 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <string.h>
+#include "latency.h"
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to get the bucket of a latency
+ * @param latency_ns : the latency in ns
+ * @return the index of the bucket
+ */
+int getLatencyBucket(uint64_t);
+
+/**
+ * @brief function to get the largest latency of a bucket
+ * @param bucket : the index of the bucket
+ * @return the latency in ns
+ */
+uint64_t getLatencyBucketBound(int);
+
+/* definition of local functions */
+
+int getLatencyBucket(uint64_t latency_ns)
+{
+    if (latency_ns < LATENCY_SUB_BUCKETS)
+    {
+        return (int)latency_ns;
+    }
+    // the 4 bits after the leading one select the bucket within the power of 2
+    int exponent = 63 - __builtin_clzll(latency_ns);
+    int sub = (int)(latency_ns >> (exponent - 4)) & (LATENCY_SUB_BUCKETS - 1);
+    return (exponent - 3) * LATENCY_SUB_BUCKETS + sub;
+}
+
+uint64_t getLatencyBucketBound(int bucket)
+{
+    if (bucket < LATENCY_SUB_BUCKETS)
+    {
+        return (uint64_t)bucket;
+    }
+    int exponent = bucket / LATENCY_SUB_BUCKETS + 3;
+    uint64_t sub = (uint64_t)(bucket % LATENCY_SUB_BUCKETS);
+    uint64_t width = 1ull << (exponent - 4);
+    return (1ull << exponent) + sub * width + (width - 1);
+}
+
+/* definitions of exported functions */
+
+void clearLatencyHistogram(t_latency_histogram *p_histogram)
+{
+    memset(p_histogram, 0, sizeof(t_latency_histogram));
+    return;
+}
+
+void addLatency(t_latency_histogram *p_histogram, uint64_t latency_ns)
+{
+    p_histogram->counts[getLatencyBucket(latency_ns)]++;
+    p_histogram->nbValues++;
+    p_histogram->total_ns += (double)latency_ns;
+    if (latency_ns > p_histogram->max_ns)
+    {
+        p_histogram->max_ns = latency_ns;
+    }
+    return;
+}
+
+void mergeLatencyHistogram(t_latency_histogram *p_histogram, const t_latency_histogram *p_other)
+{
+    for (int b = 0; b < LATENCY_NB_BUCKETS; b++)
+    {
+        p_histogram->counts[b] += p_other->counts[b];
+    }
+    p_histogram->nbValues += p_other->nbValues;
+    p_histogram->total_ns += p_other->total_ns;
+    if (p_other->max_ns > p_histogram->max_ns)
+    {
+        p_histogram->max_ns = p_other->max_ns;
+    }
+    return;
+}
+
+uint64_t getLatencyPercentile(const t_latency_histogram *p_histogram, double percentile)
+{
+    if (p_histogram->nbValues == 0)
+    {
+        return 0;
+    }
+    // rank of the percentile, from 1 to nbValues
+    uint64_t rank = (uint64_t)(percentile / 100.0 * (double)p_histogram->nbValues + 0.5);
+    if (rank < 1)
+    {
+        rank = 1;
+    }
+    if (rank >= p_histogram->nbValues)
+    {
+        return p_histogram->max_ns;
+    }
+    uint64_t seen = 0;
+    for (int b = 0; b < LATENCY_NB_BUCKETS; b++)
+    {
+        seen += p_histogram->counts[b];
+        if (seen >= rank)
+        {
+            uint64_t bound = getLatencyBucketBound(b);
+            return (bound < p_histogram->max_ns) ? bound : p_histogram->max_ns;
+        }
+    }
+    return p_histogram->max_ns;
+}
+
+void printLatencyHistogram(const t_latency_histogram *p_histogram, const char *name, FILE *file)
+{
+    double mean = (p_histogram->nbValues > 0) ? p_histogram->total_ns / (double)p_histogram->nbValues : 0.0;
+    fprintf(file, "%-6s %10llu  mean %10.0f  p50 %10llu  p90 %10llu  p99 %10llu  p99.9 %10llu  max %10llu (ns)\n", name,
+            (unsigned long long)p_histogram->nbValues, mean,
+            (unsigned long long)getLatencyPercentile(p_histogram, 50.0),
+            (unsigned long long)getLatencyPercentile(p_histogram, 90.0),
+            (unsigned long long)getLatencyPercentile(p_histogram, 99.0),
+            (unsigned long long)getLatencyPercentile(p_histogram, 99.9),
+            (unsigned long long)p_histogram->max_ns);
+    return;
+}
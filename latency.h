@@ -0,0 +1,72 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_LATENCY_H
+#define UNTITLED1_LATENCY_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @brief Number of buckets of a latency histogram per power of 2 (relative error below 1/16)
+ */
+#define LATENCY_SUB_BUCKETS 16
+
+/**
+ * @brief Number of buckets of a latency histogram : exact values below 16 ns, then 16 buckets per power of 2
+ */
+#define LATENCY_NB_BUCKETS ((64 - 3) * LATENCY_SUB_BUCKETS)
+
+/**
+ * @brief Structure for a log-linear histogram of latencies in ns, mergeable across threads
+ */
+typedef struct s_latency_histogram
+{
+    uint64_t    counts[LATENCY_NB_BUCKETS];
+    uint64_t    nbValues;
+    uint64_t    max_ns;
+    double      total_ns;
+} t_latency_histogram;
+
+/**
+ * @brief Function to empty a latency histogram
+ * @param p_histogram : pointer to the histogram
+ * @return none
+ */
+void clearLatencyHistogram(t_latency_histogram *);
+
+/**
+ * @brief Function to add a latency to a histogram
+ * @param p_histogram : pointer to the histogram
+ * @param latency_ns : the latency in ns
+ * @return none
+ */
+void addLatency(t_latency_histogram *, uint64_t);
+
+/**
+ * @brief Function to add the latencies of a histogram to another one
+ * @param p_histogram : pointer to the histogram receiving the latencies
+ * @param p_other : pointer to the histogram added
+ * @return none
+ */
+void mergeLatencyHistogram(t_latency_histogram *, const t_latency_histogram *);
+
+/**
+ * @brief Function to get a percentile of the latencies of a histogram
+ * @param p_histogram : pointer to the histogram
+ * @param percentile : the percentile, between 0 and 100
+ * @return the upper bound of the bucket of the percentile in ns (the maximum for 100), 0 for an empty histogram
+ */
+uint64_t getLatencyPercentile(const t_latency_histogram *, double);
+
+/**
+ * @brief Function to print the count, mean and percentiles (50, 90, 99, 99.9, max) of a histogram on one line
+ * @param p_histogram : pointer to the histogram
+ * @param name : the name printed first
+ * @param file : the file to print to
+ * @return none
+ */
+void printLatencyHistogram(const t_latency_histogram *, const char *, FILE *);
+
+#endif //UNTITLED1_LATENCY_H
@@ -8,6 +8,9 @@
 #include "map.h"
 #include "loc.h"
 #include "queue.h"
+#include "cpu.h"
+#include "soilscan.h"
+#include "tables.h"
 
 /* prototypes of local functions */
 /* local functions are used only in this file, as helper functions */
@@ -20,12 +23,38 @@
 t_position getBaseStationPosition(t_map);
 
 /**
- * @brief : function to calculate costs of the map  from the base station
+ * @brief : function to get the cost of a soil for a shape of table; the shape is a constant in the callers,
+ * which are thus compiled without the indirect load of the table (see calculateCostsForShape)
+ * @param p_costs : pointer to the table
+ * @param soil : the soil
+ * @param shape : the shape of the table
+ * @return the cost
+ */
+static inline int getShapedSoilCost(const t_soil_costs *, t_soil, t_cost_shape) __attribute__((always_inline));
+
+/**
+ * @brief : function to calculate costs of the map from the base station, for a shape of soil cost table
+ * @param map : the map
+ * @param shape : the shape of the soil costs of the map
+ * @return none
+ */
+static inline void calculateCostsForShape(t_map, t_cost_shape) __attribute__((always_inline));
+
+/**
+ * @brief : function to calculate costs of the map  from the base station, with the engine of its soil costs
  * @param map : the map
  * @return none
  */
 void calculateCosts(t_map);
 
+/**
+ * @brief : qsort comparison of the keys of the false crevasses (cost in the high 32 bits, cell in the low ones)
+ * @param a : pointer to the first key
+ * @param b : pointer to the second key
+ * @return the comparison result
+ */
+int compareFalseCrevasses(const void *, const void *);
+
 /**
  * @brief : function to remove 'false' crevasses costs from the costs array
  * @param map : the map
@@ -35,63 +64,71 @@ void removeFalseCrevasses(t_map);
 
 /* definition of local functions */
 
+const t_soil_costs _default_soil_costs = {{0, 1, 2, 4, 10000}, COST_SHAPE_BYTE, 0x04020100};
+
 t_position getBaseStationPosition(t_map map)
 {
-    t_position pos;
-    int i = 0;
-    int found = 0;
-    while (i < map.y_max && !found)
+    // the scan done when the map was loaded, maps made otherwise are scanned now
+    t_soil_summary summary = map.summary;
+    if (summary.nbBases < 0)
     {
-        int j = 0;
-        while (j < map.x_max && !found)
-        {
-            if (map.soils[i][j] == BASE_STATION)
-            {
-                pos.x = j;
-                pos.y = i;
-                found = 1;
-            }
-            j++;
-        }
-        i++;
+        t_soil_scan scan = scanSoils(map);
+        summary = getSoilSummary(&scan);
+        freeSoilScan(&scan);
     }
     // if the base station is not found, we exit the program
-    if (!found)
+    if (summary.nbBases == 0)
     {
         fprintf(stderr, "Error: base station not found in the map\n");
         exit(1);
     }
-    return pos;
+    // the first one, row by row
+    return summary.base;
+}
+
+int compareFalseCrevasses(const void *a, const void *b)
+{
+    uint64_t ka = *(const uint64_t *)a, kb = *(const uint64_t *)b;
+    return (ka > kb) - (ka < kb);
 }
 
 void removeFalseCrevasses(t_map map)
 {
-    // step 1 : find the minimal cost > 10000 in the costs array where the soil is not a crevasse
-    int over=0;
-    int imin, jmin;
-    while (!over)
+    // the cells whose cost is over the crevasse cost without being crevasses are lowered from their neighbours,
+    // by increasing cost then row by row; a cell that cannot be lowered is left for the next pass, which only
+    // runs if a cost was lowered : the costs only decrease, so the passes end
+    int threshold = map.soil_costs->cost[CREVASSE];
+    uint64_t *candidates = (uint64_t *)malloc((size_t)map.x_max * map.y_max * sizeof(uint64_t));
+    int lowered = 1;
+    while (lowered)
     {
-        int min_cost = COST_UNDEF;
-        imin = map.y_max;
-        jmin = map.x_max;
+        // step 1 : find the costs > crevasse cost where the soil is not a crevasse, key = cost then cell
+        int nbCandidates = 0;
         for (int i=0; i<map.y_max; i++)
         {
+            // the SIMD kernel of the CPU skips the rows without any (see cpu.c)
+            int min_cost = COST_UNDEF;
+            if (_kernels.rowMinFalseCrevasse(map.soils[i], map.costs[i], map.x_max, threshold, &min_cost) < 0)
+            {
+                continue;
+            }
             for (int j=0; j<map.x_max; j++)
             {
-                if (map.soils[i][j] != CREVASSE && map.costs[i][j] > 10000 && map.costs[i][j] < min_cost)
+                if (map.soils[i][j] != CREVASSE && map.costs[i][j] > threshold && map.costs[i][j] < COST_UNDEF)
                 {
-                    min_cost = map.costs[i][j];
-                    imin = i;
-                    jmin = j;
+                    candidates[nbCandidates++] = ((uint64_t)map.costs[i][j] << 32) | (uint64_t)(i * map.x_max + j);
                 }
             }
         }
-        if (imin < map.y_max && jmin < map.x_max)
+        qsort(candidates, nbCandidates, sizeof(uint64_t), compareFalseCrevasses);
+        lowered = 0;
+        for (int c = 0; c < nbCandidates; c++)
         {
             // step 2 : calculate the costs of the neighbours of the position
+            int cell = (int)(candidates[c] & 0xFFFFFFFFu);
             t_position pos;
-            pos.x = jmin;
-            pos.y = imin;
+            pos.x = cell % map.x_max;
+            pos.y = cell / map.x_max;
             t_position lp, rp, up, dp;
             lp = LEFT(pos);
             rp = RIGHT(pos);
@@ -114,17 +151,56 @@ void removeFalseCrevasses(t_map map)
             {
                 min_neighbour = (map.costs[dp.y][dp.x] < min_neighbour) ? map.costs[dp.y][dp.x] : min_neighbour;
             }
-            int self_cost = _soil_cost[map.soils[imin][jmin]];
-            map.costs[imin][jmin] = (min_neighbour + self_cost < map.costs[imin][jmin]) ? min_neighbour + self_cost : map.costs[imin][jmin];
-        }
-        else
-        {
-            over = 1;
+            int self_cost = getSoilCost(map.soil_costs, map.soils[pos.y][pos.x]);
+            if (min_neighbour + self_cost < map.costs[pos.y][pos.x])
+            {
+                map.costs[pos.y][pos.x] = min_neighbour + self_cost;
+                lowered = 1;
+            }
         }
     }
+    free(candidates);
+    return;
+}
+
+int getShapedSoilCost(const t_soil_costs *p_costs, t_soil soil, t_cost_shape shape)
+{
+    switch (shape)
+    {
+        case COST_SHAPE_UNIFORM:
+            return (soil == CREVASSE) ? p_costs->cost[CREVASSE] : (soil == BASE_STATION) ? 0 : p_costs->cost[PLAIN];
+        case COST_SHAPE_BYTE:
+            return (soil == CREVASSE) ? p_costs->cost[CREVASSE] : (int)((p_costs->packed >> (8 * soil)) & 0xFF);
+        case COST_SHAPE_POW2:
+            return (soil == CREVASSE) ? p_costs->cost[CREVASSE]
+                 : (soil == BASE_STATION) ? 0 : 1 << ((p_costs->packed >> (8 * soil)) & 0xFF);
+        default:
+            return p_costs->cost[soil];
+    }
 }
 
 void calculateCosts(t_map map)
+{
+    // one copy of the engine per shape, chosen once per map
+    switch (map.soil_costs->shape)
+    {
+        case COST_SHAPE_UNIFORM:
+            calculateCostsForShape(map, COST_SHAPE_UNIFORM);
+            break;
+        case COST_SHAPE_BYTE:
+            calculateCostsForShape(map, COST_SHAPE_BYTE);
+            break;
+        case COST_SHAPE_POW2:
+            calculateCostsForShape(map, COST_SHAPE_POW2);
+            break;
+        default:
+            calculateCostsForShape(map, COST_SHAPE_GENERIC);
+            break;
+    }
+    return;
+}
+
+void calculateCostsForShape(t_map map, t_cost_shape shape)
 {
     t_position baseStation = getBaseStationPosition(map);
     //create a queue to store the positions to visit
@@ -137,7 +213,7 @@ void calculateCosts(t_map map)
         // dequeue the position
         t_position pos = dequeue(&queue);
         // get its self cost
-        int self_cost = _soil_cost[map.soils[pos.y][pos.x]];
+        int self_cost = getShapedSoilCost(map.soil_costs, map.soils[pos.y][pos.x], shape);
         // get ts neighbours
         t_position lp, rp, up, dp;
         lp = LEFT(pos);
@@ -187,13 +263,101 @@ void calculateCosts(t_map map)
             enqueue(&queue, dp);
         }
     }
-
-
+    free(queue.values);
     return;
 }
 /* definition of exported functions */
 
 t_map createMapFromFile(char *filename)
+{
+    return createMapFromFileWithCosts(filename, &_default_soil_costs);
+}
+
+t_map createMapFromFileWithCosts(char *filename, const t_soil_costs *p_costs)
+{
+    t_map map = createMapSoilsFromFile(filename);
+    map.soil_costs = p_costs;
+    calculateCosts(map);
+    removeFalseCrevasses(map);
+    return map;
+}
+
+t_soil_costs createSoilCosts(const int *costs)
+{
+    t_soil_costs table;
+    memcpy(table.cost, costs, sizeof(table.cost));
+    if (costs[BASE_STATION] != 0)
+    {
+        fprintf(stderr, "Error: the base station costs %d, it must cost 0\n", costs[BASE_STATION]);
+        exit(1);
+    }
+    // the cost engine marks the cells to visit with COST_UNDEF - 1 and the cells not reached with COST_UNDEF
+    if (costs[CREVASSE] >= COST_UNDEF - 1)
+    {
+        fprintf(stderr, "Error: the crevasse costs %d, it must cost less than %d\n", costs[CREVASSE], COST_UNDEF - 1);
+        exit(1);
+    }
+    int uniform = 1, byte = 1, pow2 = 1;
+    table.packed = 0;
+    for (int s = PLAIN; s < CREVASSE; s++)
+    {
+        if (costs[s] < 1 || costs[s] >= costs[CREVASSE])
+        {
+            fprintf(stderr, "Error: soil %d costs %d, it must cost from 1 to %d\n", s, costs[s], costs[CREVASSE] - 1);
+            exit(1);
+        }
+        uniform = uniform && (costs[s] == costs[PLAIN]);
+        byte = byte && (costs[s] < 256);
+        pow2 = pow2 && ((costs[s] & (costs[s] - 1)) == 0);
+    }
+    if (uniform)
+    {
+        table.shape = COST_SHAPE_UNIFORM;
+    }
+    else if (byte)
+    {
+        table.shape = COST_SHAPE_BYTE;
+        for (int s = PLAIN; s < CREVASSE; s++)
+        {
+            table.packed |= (uint64_t)costs[s] << (8 * s);
+        }
+    }
+    else if (pow2)
+    {
+        table.shape = COST_SHAPE_POW2;
+        for (int s = PLAIN; s < CREVASSE; s++)
+        {
+            table.packed |= (uint64_t)__builtin_ctz(costs[s]) << (8 * s);
+        }
+    }
+    else
+    {
+        table.shape = COST_SHAPE_GENERIC;
+    }
+    return table;
+}
+
+int getSoilCost(const t_soil_costs *p_costs, t_soil soil)
+{
+    return p_costs->cost[soil];
+}
+
+void setMapSoilCosts(t_map *p_map, const t_soil_costs *p_costs)
+{
+    p_map->soil_costs = p_costs;
+    for (int i = 0; i < p_map->y_max; i++)
+    {
+        for (int j = 0; j < p_map->x_max; j++)
+        {
+            p_map->costs[i][j] = (p_map->soils[i][j] == BASE_STATION) ? 0 : COST_UNDEF;
+        }
+    }
+    calculateCosts(*p_map);
+    removeFalseCrevasses(*p_map);
+    return;
+}
+
+t_map createMapSoilsFromFile(char *filename)
 {
     /* rules for the file :
      * - the first line contains the number of lines : y dimension (int)
@@ -216,6 +380,8 @@ t_map createMapFromFile(char *filename)
     fscanf(file, "%d", &xdim);
     map.x_max = xdim;
     map.y_max = ydim;
+    map.soil_costs = &_default_soil_costs;
+    map.summary.nbBases = -1;
     map.soils = (t_soil **)malloc(ydim * sizeof(t_soil *));
     for (int i = 0; i < ydim; i++)
     {
@@ -234,16 +400,23 @@ t_map createMapFromFile(char *filename)
         for (int j = 0; j < xdim; j++)
         {
             int value;
-            fscanf(file, "%d", &value);
-            map.soils[i][j] = value;
+            if (fscanf(file, "%d", &value) != 1)
+            {
+                fprintf(stderr, "Error: cannot read line %d, column %d of map %s\n", i, j, filename);
+                exit(1);
+            }
+            // the value is checked by the scan below, once the whole map is read
+            map.soils[i][j] = (t_soil)value;
             // cost is 0 for BASE_STATION, 65535 for other soils
             map.costs[i][j] = (value == BASE_STATION) ? 0 : COST_UNDEF;
         }
 
     }
     fclose(file);
-    calculateCosts(map);
-    removeFalseCrevasses(map);
+    t_soil_scan scan = scanSoils(map);
+    checkSoilScan(&scan, filename);
+    map.summary = getSoilSummary(&scan);
+    freeSoilScan(&scan);
     return map;
 }
 
@@ -264,35 +437,8 @@ void displayMap(t_map map)
         {
             for (int j = 0; j < map.x_max; j++)
             {
-                char c[4];
-                switch (map.soils[i][j])
-                {
-                    case BASE_STATION:
-                        if (rep==1)
-                        {
-                            strcpy(c, " B ");
-                        }
-                        else
-                        {
-                            strcpy(c, "   ");
-                        }
-                        break;
-                    case PLAIN:
-                        strcpy(c, "---");
-                        break;
-                    case ERG:
-                        strcpy(c, "~~~");
-                        break;
-                    case REG:
-                        strcpy(c, "^^^");
-                        break;
-                    case CREVASSE:
-                        sprintf(c, "%c%c%c",219,219,219);
-                        break;
-                    default:
-                        strcpy(c, "???");
-                        break;
-                }
+                // glyphs are generated at build time in tables.h
+                const char *c = ((unsigned)map.soils[i][j] <= CREVASSE) ? _soil_glyphs[map.soils[i][j]][rep] : "???";
                 printf("%s", c);
             }
             printf("\n");
@@ -5,6 +5,9 @@
 #ifndef UNTITLED1_MAP_H
 #define UNTITLED1_MAP_H
 
+#include <stdint.h>
+#include "loc.h"
+
 #define COST_UNDEF 65535
 /**
  * @brief Enum for the possible soils of the map
@@ -19,9 +22,41 @@ typedef enum e_soil
 } t_soil;
 
 /**
- * @brief Array of costs for the soils
+ * @brief Enum for the shapes of soil cost tables the cost engines are specialised for
+ */
+typedef enum e_cost_shape
+{
+    COST_SHAPE_GENERIC, // costs read from the table
+    COST_SHAPE_POW2,    // plain, erg and reg cost powers of 2 : the costs are shifts
+    COST_SHAPE_BYTE,    // plain, erg and reg cost less than 256 : the costs are bytes of a register
+    COST_SHAPE_UNIFORM  // plain, erg and reg have the same cost
+} t_cost_shape;
+
+/**
+ * @brief Structure for the costs of the soils of a map
+ */
+typedef struct s_soil_costs
+{
+    int             cost[CREVASSE + 1];
+    t_cost_shape    shape;
+    uint64_t        packed; // byte s : the cost of soil s (COST_SHAPE_BYTE) or its log2 (COST_SHAPE_POW2)
+} t_soil_costs;
+
+/**
+ * @brief The default soil costs (base station 0, plain 1, erg 2, reg 4, crevasse 10000), used by the maps
+ * loaded without a table
+ */
+extern const t_soil_costs _default_soil_costs;
+
+/**
+ * @brief Structure for what the scan of the soils of a map found when it was loaded (see soilscan.h)
  */
-static const int _soil_cost[5] = {0, 1, 2, 4, 10000};
+typedef struct s_soil_summary
+{
+    int         counts[CREVASSE + 1];   // number of cells of each soil
+    t_position  base;                   // the first base station, row by row
+    int         nbBases;                // -1 if the soils were not scanned (views, packs, bundles)
+} t_soil_summary;
 
 /**
  * @brief Structure for the map
@@ -33,6 +68,8 @@ typedef struct s_map
     int     **costs;
     int     x_max;
     int     y_max;
+    const t_soil_costs *soil_costs; // never NULL, shared (not freed with the map)
+    t_soil_summary  summary;
 } t_map;
 
 /**
@@ -42,6 +79,46 @@ typedef struct s_map
  */
 t_map createMapFromFile(char *);
 
+/**
+ * @brief Function to initialise the map from a file, with the costs of a mission profile
+ * @param filename : the name of the file
+ * @param p_costs : pointer to the costs of the soils, which must live as long as the map
+ * @return the map
+ */
+t_map createMapFromFileWithCosts(char *, const t_soil_costs *);
+
+/**
+ * @brief Function to create a soil cost table and find its shape
+ * the base station costs 0, plain, erg and reg cost at least 1 and less than a crevasse
+ * @param costs : the 5 costs, indexed by t_soil
+ * @return the table
+ */
+t_soil_costs createSoilCosts(const int *);
+
+/**
+ * @brief Function to get the cost of a soil
+ * @param p_costs : pointer to the table
+ * @param soil : the soil
+ * @return the cost
+ */
+int getSoilCost(const t_soil_costs *, t_soil);
+
+/**
+ * @brief Function to change the soil costs of a map and compute its costs again
+ * @param p_map : pointer to the map
+ * @param p_costs : pointer to the costs of the soils, which must live as long as the map
+ * @return none
+ */
+void setMapSoilCosts(t_map *, const t_soil_costs *);
+
+/**
+ * @brief Function to read the soils of a map file, without computing its costs (they are left to COST_UNDEF,
+ * 0 on base stations, the soil costs are the default ones) : the file may have no base station, e.g. a tile of a larger map
+ * @param filename : the name of the file
+ * @return the map
+ */
+t_map createMapSoilsFromFile(char *);
+
 /**
  * @brief Function to create a standard training map (11x11 with only plains and base station in the middle)
  * @param none
@@ -0,0 +1,58 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bundle.h"
+
+/**
+ * mapbundle [-r <max reach>] <bundle file> <map file> : builds the bundle of a map (planner bounds up to
+ *                                                      max reach cells, 15 by default)
+ * mapbundle -l <bundle file>                           : lists the sections of a bundle
+ */
+int main(int argc, char **argv)
+{
+    static const char *names[NB_BUNDLE_SECTIONS] = {"soils", "costs", "reach", "tree", "plane"};
+    if (argc == 3 && strcmp(argv[1], "-l") == 0)
+    {
+        t_bundle *p_bundle = openBundle(argv[2]);
+        printf("%dx%d\n", p_bundle->map.y_max, p_bundle->map.x_max);
+        for (int s = 0; s < NB_BUNDLE_SECTIONS; s++)
+        {
+            if (p_bundle->entries[s] != NULL)
+            {
+                printf("%-6s offset %10llu size %10llu extra %u\n", names[s],
+                       (unsigned long long)p_bundle->entries[s]->offset,
+                       (unsigned long long)p_bundle->entries[s]->size, p_bundle->entries[s]->extra);
+            }
+        }
+        closeBundle(p_bundle);
+        return 0;
+    }
+    int max_reach = 15;
+    int first = 1;
+    if (argc == 5 && strcmp(argv[1], "-r") == 0)
+    {
+        max_reach = atoi(argv[2]);
+        first = 3;
+    }
+    if (argc != first + 2 || max_reach < 0)
+    {
+        fprintf(stderr, "Usage: %s [-r <max reach>] <bundle file> <map file>\n       %s -l <bundle file>\n",
+                argv[0], argv[0]);
+        return 1;
+    }
+    t_map map = createMapFromFile(argv[first + 1]);
+    writeBundle(argv[first], map, max_reach);
+    for (int y = 0; y < map.y_max; y++)
+    {
+        free(map.soils[y]);
+        free(map.costs[y]);
+    }
+    free(map.soils);
+    free(map.costs);
+    printf("%s bundled in %s\n", argv[first + 1], argv[first]);
+    return 0;
+}
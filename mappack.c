@@ -0,0 +1,106 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pack.h"
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief qsort comparison of file names
+ * @param a : pointer to the first name
+ * @param b : pointer to the second name
+ * @return the comparison result
+ */
+int compareFileNames(const void *, const void *);
+
+/* definition of local functions */
+
+int compareFileNames(const void *a, const void *b)
+{
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/**
+ * mappack [-c] <pack file> <directory> : packs the .map files of a directory, named without their extension
+ *                                        (-c : with their costs)
+ * mappack -l <pack file>               : lists the maps of a pack
+ */
+int main(int argc, char **argv)
+{
+    if (argc == 3 && strcmp(argv[1], "-l") == 0)
+    {
+        t_pack pack = openPack(argv[2]);
+        for (uint64_t s = 0; s < pack.nbSlots; s++)
+        {
+            if (pack.slots[s].name != 0)
+            {
+                printf("%s %ux%u%s\n", pack.data + pack.slots[s].name, pack.slots[s].y_max, pack.slots[s].x_max,
+                       (pack.slots[s].costs != 0) ? " costs" : "");
+            }
+        }
+        closePack(&pack);
+        return 0;
+    }
+    int withCosts = (argc == 4 && strcmp(argv[1], "-c") == 0);
+    if (argc != 3 + withCosts)
+    {
+        fprintf(stderr, "Usage: %s [-c] <pack file> <directory>\n       %s -l <pack file>\n", argv[0], argv[0]);
+        return 1;
+    }
+    char *packname = argv[1 + withCosts];
+    char *dirname = argv[2 + withCosts];
+
+    DIR *dir = opendir(dirname);
+    if (dir == NULL)
+    {
+        fprintf(stderr, "Error: cannot open directory %s\n", dirname);
+        return 1;
+    }
+    // the files are packed in name order, so that a pack only depends on the directory
+    int nbFiles = 0, capacity = 64;
+    char **files = (char **)malloc(capacity * sizeof(char *));
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL)
+    {
+        size_t length = strlen(entry->d_name);
+        if (length > 4 && strcmp(entry->d_name + length - 4, ".map") == 0)
+        {
+            if (nbFiles == capacity)
+            {
+                capacity *= 2;
+                files = (char **)realloc(files, capacity * sizeof(char *));
+            }
+            files[nbFiles++] = strdup(entry->d_name);
+        }
+    }
+    closedir(dir);
+    qsort(files, nbFiles, sizeof(char *), compareFileNames);
+
+    t_pack_writer writer = createPackWriter(packname);
+    for (int i = 0; i < nbFiles; i++)
+    {
+        char path[4096];
+        snprintf(path, sizeof(path), "%s/%s", dirname, files[i]);
+        t_map map = withCosts ? createMapFromFile(path) : createMapSoilsFromFile(path);
+        files[i][strlen(files[i]) - 4] = '\0';
+        addPackMap(&writer, files[i], map, withCosts);
+        for (int y = 0; y < map.y_max; y++)
+        {
+            free(map.soils[y]);
+            free(map.costs[y]);
+        }
+        free(map.soils);
+        free(map.costs);
+        free(files[i]);
+    }
+    closePackWriter(&writer);
+    free(files);
+    printf("%d maps packed in %s\n", nbFiles, packname);
+    return 0;
+}
@@ -0,0 +1,391 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "mission.h"
+
+/**
+ * @brief Magic number at the start of a summary file
+ */
+#define SUMMARY_MAGIC "MARCSUM1"
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to get the bin of a final cost in the cost histogram
+ * @param cost : the cost
+ * @return the bin
+ */
+int getCostBin(int);
+
+/**
+ * @brief function to build the name of a file of a shard
+ * @param buffer : the buffer receiving the name
+ * @param size : the size of the buffer
+ * @param prefix : the prefix of the campaign
+ * @param shard : the index of the shard, -1 for the merged file
+ * @param extension : the extension of the file
+ * @return the buffer
+ */
+char *getShardFilename(char *, size_t, char *, int, char *);
+
+/**
+ * @brief function to start a shard in a child process
+ * @param p_config : pointer to the parameters
+ * @param seed_begin : the first seed of the shard
+ * @param seed_end : the seed after the last one
+ * @param prefix : the prefix of the campaign
+ * @param shard : the index of the shard
+ * @return the pid of the child
+ */
+pid_t startShard(const t_mission_config *, uint64_t, uint64_t, char *, int);
+
+/* definition of local functions */
+
+int getCostBin(int cost)
+{
+    int bin = 0;
+    while (cost > 0 && bin < MISSION_COST_BINS - 1)
+    {
+        cost >>= 1;
+        bin++;
+    }
+    return bin;
+}
+
+char *getShardFilename(char *buffer, size_t size, char *prefix, int shard, char *extension)
+{
+    if (shard < 0)
+    {
+        snprintf(buffer, size, "%s.%s", prefix, extension);
+    }
+    else
+    {
+        snprintf(buffer, size, "%s.%d.%s", prefix, shard, extension);
+    }
+    return buffer;
+}
+
+pid_t startShard(const t_mission_config *p_config, uint64_t seed_begin, uint64_t seed_end, char *prefix, int shard)
+{
+    // buffered output would be written twice otherwise
+    fflush(stdout);
+    fflush(stderr);
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        fprintf(stderr, "Error: cannot start shard %d\n", shard);
+        exit(1);
+    }
+    if (pid == 0)
+    {
+        char results[4096], summary_file[4096];
+        getShardFilename(results, sizeof(results), prefix, shard, "res");
+        getShardFilename(summary_file, sizeof(summary_file), prefix, shard, "sum");
+        t_campaign_summary summary = runCampaign(p_config, seed_begin, seed_end, results);
+        saveCampaignSummary(&summary, summary_file);
+        _exit(0);
+    }
+    return pid;
+}
+
+/* definitions of exported functions */
+
+int plannerStrategy(t_map map, t_localisation loc, const t_move *draw, int nbDraw, int nbChoose, t_move *chosen, void *ctx)
+{
+    (void)map;
+    t_plan plan;
+    if (!planBest((const t_planner *)ctx, loc, draw, nbDraw, nbChoose, &plan))
+    {
+        return 0;
+    }
+    memcpy(chosen, plan.moves, plan.nbMoves * sizeof(t_move));
+    return plan.nbMoves;
+}
+
+t_mission_config createMissionConfig(t_planner *p_planner, int nbDraw, int nbChoose, int maxPhases)
+{
+    assert(nbDraw > 0 && nbDraw <= PLAN_MAX_MOVES);
+    assert(maxPhases > 0 && maxPhases <= MISSION_MAX_PHASES);
+    t_mission_config config;
+    config.map = p_planner->map;
+    config.nbDraw = nbDraw;
+    config.nbChoose = nbChoose;
+    config.maxPhases = maxPhases;
+    config.strategy = plannerStrategy;
+    config.ctx = p_planner;
+    config.phaseEnd = NULL;
+    config.rt = NULL;
+    return config;
+}
+
+t_localisation drawStartLocalisation(t_map map, uint64_t seed)
+{
+    // stream 0 of the seed is the start, stream p + 1 the draw of phase p
+    t_rng rng = createRng(seed, 0);
+    int x = 0, y = 0;
+    for (int tries = 0; tries < 1000; tries++)
+    {
+        x = randomBelow(&rng, map.x_max);
+        y = randomBelow(&rng, map.y_max);
+        if (map.soils[y][x] != CREVASSE && map.soils[y][x] != BASE_STATION)
+        {
+            break;
+        }
+    }
+    return loc_init(x, y, (t_orientation)randomBelow(&rng, 4));
+}
+
+void drawPhaseMoves(uint64_t seed, int phase, t_move *draw, int nbDraw)
+{
+    t_rng rng = createRng(seed, (uint64_t)phase + 1);
+    drawMoves(&rng, draw, nbDraw);
+    return;
+}
+
+t_mission_record simulateMission(const t_mission_config *p_config, uint64_t seed)
+{
+    t_map map = p_config->map;
+    t_mission_record record;
+    t_localisation loc = drawStartLocalisation(map, seed);
+    record.seed = seed;
+    record.start = loc;
+    record.nbPhases = 0;
+    record.outcome = (map.soils[loc.pos.y][loc.pos.x] == BASE_STATION) ? OUTCOME_BASE : OUTCOME_TIMEOUT;
+    while (record.outcome == OUTCOME_TIMEOUT && record.nbPhases < p_config->maxPhases)
+    {
+        t_move draw[PLAN_MAX_MOVES], chosen[PLAN_MAX_MOVES];
+        if (p_config->rt != NULL)
+        {
+            rtBeginPhase(p_config->rt);
+        }
+        drawPhaseMoves(seed, record.nbPhases, draw, p_config->nbDraw);
+        int nbChosen = p_config->strategy(map, loc, draw, p_config->nbDraw, p_config->nbChoose, chosen, p_config->ctx);
+        // without a safe sequence the robot still has to move
+        if (nbChosen == 0)
+        {
+            chosen[0] = draw[0];
+            nbChosen = 1;
+        }
+        record.nbPhases++;
+        for (int i = 0; i < nbChosen; i++)
+        {
+            updateLocalisation(&loc, chosen[i]);
+            if (!isValidLocalisation(loc.pos, map.x_max, map.y_max))
+            {
+                record.outcome = OUTCOME_OUT;
+                break;
+            }
+            if (map.soils[loc.pos.y][loc.pos.x] == CREVASSE)
+            {
+                record.outcome = OUTCOME_CREVASSE;
+                break;
+            }
+            if (map.soils[loc.pos.y][loc.pos.x] == BASE_STATION)
+            {
+                record.outcome = OUTCOME_BASE;
+                break;
+            }
+        }
+        if (p_config->rt != NULL)
+        {
+            rtEndPhase(p_config->rt);
+        }
+        if (p_config->phaseEnd != NULL && record.outcome == OUTCOME_TIMEOUT && record.nbPhases < p_config->maxPhases)
+        {
+            p_config->phaseEnd(loc, p_config->ctx);
+        }
+    }
+    record.finalCost = (record.outcome == OUTCOME_OUT) ? COST_UNDEF : map.costs[loc.pos.y][loc.pos.x];
+    return record;
+}
+
+t_campaign_summary createCampaignSummary(uint64_t seed_begin, uint64_t seed_end)
+{
+    t_campaign_summary summary;
+    memset(&summary, 0, sizeof(t_campaign_summary));
+    summary.seed_begin = seed_begin;
+    summary.seed_end = seed_end;
+    return summary;
+}
+
+void addToCampaignSummary(t_campaign_summary *p_summary, const t_mission_record *p_record)
+{
+    p_summary->nbMissions++;
+    p_summary->nbOutcomes[p_record->outcome]++;
+    p_summary->phaseHistogram[(p_record->nbPhases < MISSION_MAX_PHASES) ? p_record->nbPhases : MISSION_MAX_PHASES]++;
+    p_summary->totalPhases += p_record->nbPhases;
+    if (p_record->finalCost != COST_UNDEF)
+    {
+        p_summary->costHistogram[getCostBin(p_record->finalCost)]++;
+    }
+    return;
+}
+
+void mergeCampaignSummaries(t_campaign_summary *p_summary, const t_campaign_summary *p_other)
+{
+    assert(p_summary->seed_end == p_other->seed_begin);
+    p_summary->seed_end = p_other->seed_end;
+    p_summary->nbMissions += p_other->nbMissions;
+    p_summary->totalPhases += p_other->totalPhases;
+    for (int i = 0; i < 4; i++)
+    {
+        p_summary->nbOutcomes[i] += p_other->nbOutcomes[i];
+    }
+    for (int i = 0; i <= MISSION_MAX_PHASES; i++)
+    {
+        p_summary->phaseHistogram[i] += p_other->phaseHistogram[i];
+    }
+    for (int i = 0; i < MISSION_COST_BINS; i++)
+    {
+        p_summary->costHistogram[i] += p_other->costHistogram[i];
+    }
+    return;
+}
+
+void saveCampaignSummary(const t_campaign_summary *p_summary, char *filename)
+{
+    FILE *file = fopen(filename, "wb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Error: cannot open file %s\n", filename);
+        exit(1);
+    }
+    if (fwrite(SUMMARY_MAGIC, 8, 1, file) != 1 || fwrite(p_summary, sizeof(t_campaign_summary), 1, file) != 1
+        || fclose(file) != 0)
+    {
+        fprintf(stderr, "Error: cannot write file %s\n", filename);
+        exit(1);
+    }
+    return;
+}
+
+int loadCampaignSummary(char *filename, t_campaign_summary *p_summary)
+{
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL)
+    {
+        return 0;
+    }
+    char magic[8];
+    int ok = (fread(magic, 8, 1, file) == 1 && memcmp(magic, SUMMARY_MAGIC, 8) == 0
+              && fread(p_summary, sizeof(t_campaign_summary), 1, file) == 1);
+    fclose(file);
+    return ok;
+}
+
+t_campaign_summary runCampaign(const t_mission_config *p_config, uint64_t seed_begin, uint64_t seed_end, char *results)
+{
+    t_campaign_summary summary = createCampaignSummary(seed_begin, seed_end);
+    t_results_file *p_file = (results != NULL) ? createResultsFile(results) : NULL;
+    t_results_writer writer;
+    if (p_file != NULL)
+    {
+        writer = createResultsWriter(p_file);
+    }
+    for (uint64_t seed = seed_begin; seed < seed_end; seed++)
+    {
+        t_mission_record record = simulateMission(p_config, seed);
+        addToCampaignSummary(&summary, &record);
+        if (p_file != NULL)
+        {
+            appendResult(&writer, &record);
+        }
+    }
+    if (p_file != NULL)
+    {
+        closeResultsWriter(&writer);
+        closeResultsFile(p_file);
+    }
+    return summary;
+}
+
+t_campaign_summary runShardedCampaign(const t_mission_config *p_config, uint64_t seed_begin, uint64_t seed_end,
+                                      int nbShards, char *prefix)
+{
+    assert(nbShards > 0 && seed_begin <= seed_end);
+    uint64_t *bounds = (uint64_t *)malloc((nbShards + 1) * sizeof(uint64_t));
+    pid_t *pids = (pid_t *)malloc(nbShards * sizeof(pid_t));
+    for (int i = 0; i <= nbShards; i++)
+    {
+        bounds[i] = seed_begin + (seed_end - seed_begin) * i / nbShards;
+    }
+    for (int i = 0; i < nbShards; i++)
+    {
+        pids[i] = startShard(p_config, bounds[i], bounds[i + 1], prefix, i);
+    }
+    for (int i = 0; i < nbShards; i++)
+    {
+        // a crashed shard does not affect the others : it is run once more on its own
+        for (int attempt = 0; attempt < 2; attempt++)
+        {
+            int status;
+            char summary_file[4096];
+            t_campaign_summary summary;
+            waitpid(pids[i], &status, 0);
+            if (WIFEXITED(status) && WEXITSTATUS(status) == 0
+                && loadCampaignSummary(getShardFilename(summary_file, sizeof(summary_file), prefix, i, "sum"), &summary))
+            {
+                break;
+            }
+            if (attempt == 1)
+            {
+                fprintf(stderr, "Error: shard %d (seeds %llu to %llu) failed twice\n", i,
+                        (unsigned long long)bounds[i], (unsigned long long)bounds[i + 1]);
+                exit(1);
+            }
+            fprintf(stderr, "Warning: shard %d failed, running it again\n", i);
+            pids[i] = startShard(p_config, bounds[i], bounds[i + 1], prefix, i);
+        }
+    }
+    free(pids);
+    free(bounds);
+    return mergeCampaignShards(prefix, nbShards);
+}
+
+t_campaign_summary mergeCampaignShards(char *prefix, int nbShards)
+{
+    char filename[4096];
+    t_campaign_summary merged;
+    t_results_file *p_file = createResultsFile(getShardFilename(filename, sizeof(filename), prefix, -1, "res"));
+    t_results_writer writer = createResultsWriter(p_file);
+    for (int i = 0; i < nbShards; i++)
+    {
+        t_campaign_summary summary;
+        if (!loadCampaignSummary(getShardFilename(filename, sizeof(filename), prefix, i, "sum"), &summary))
+        {
+            fprintf(stderr, "Error: cannot load the summary of shard %d\n", i);
+            exit(1);
+        }
+        if (i == 0)
+        {
+            merged = summary;
+        }
+        else
+        {
+            mergeCampaignSummaries(&merged, &summary);
+        }
+        // records are rewritten through a single writer so the chunks match those of a single process
+        t_results_view view = openResultsView(getShardFilename(filename, sizeof(filename), prefix, i, "res"));
+        for (int c = 0; c < view.nbChunks; c++)
+        {
+            t_results_chunk chunk = getResultsChunk(view, c);
+            for (int r = 0; r < chunk.nbRows; r++)
+            {
+                t_mission_record record = getResultsRecord(chunk, r);
+                appendResult(&writer, &record);
+            }
+        }
+        closeResultsView(&view);
+    }
+    closeResultsWriter(&writer);
+    closeResultsFile(p_file);
+    return merged;
+}
@@ -0,0 +1,198 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_MISSION_H
+#define UNTITLED1_MISSION_H
+
+#include <stdint.h>
+#include "draw.h"
+#include "map.h"
+#include "planner.h"
+#include "results.h"
+#include "rt.h"
+
+/**
+ * @brief Maximal number of phases of a simulated mission
+ */
+#define MISSION_MAX_PHASES 255
+
+/**
+ * @brief Number of bins of the final cost histogram (bin b holds costs in [2^(b-1), 2^b), bin 0 the cost 0)
+ */
+#define MISSION_COST_BINS 18
+
+/**
+ * @brief Type for a move-choice strategy : orders (a subset of) the moves drawn for a phase
+ * @param map : the map
+ * @param loc : the localisation of the robot
+ * @param draw : the moves drawn
+ * @param nbDraw : the number of moves drawn
+ * @param nbChoose : the maximal number of moves to choose
+ * @param chosen : array receiving the moves to do, in order
+ * @param ctx : the context of the strategy
+ * @return the number of moves chosen, 0 if the strategy found no safe sequence
+ */
+typedef int (*t_strategy)(t_map, t_localisation, const t_move *, int, int, t_move *, void *);
+
+/**
+ * @brief Type for a function called at the end of each phase of a mission, e.g. to prepare the next phase
+ * while the robot moves
+ * @param loc : the localisation of the robot at the end of the phase
+ * @param ctx : the context of the strategy
+ */
+typedef void (*t_phase_end)(t_localisation, void *);
+
+/**
+ * @brief Structure for the parameters of simulated missions
+ */
+typedef struct s_mission_config
+{
+    t_map       map;
+    int         nbDraw;     // moves drawn per phase
+    int         nbChoose;   // moves chosen per phase
+    int         maxPhases;
+    t_strategy  strategy;
+    void        *ctx;       // context of the strategy
+    t_phase_end phaseEnd;   // called after each phase, outside of its real-time bracket, NULL for none
+    t_rt        *rt;        // real-time context bracketing each phase, NULL for none
+} t_mission_config;
+
+/**
+ * @brief Structure for the mergeable summary of a campaign of missions
+ */
+typedef struct s_campaign_summary
+{
+    uint64_t    seed_begin;
+    uint64_t    seed_end;
+    uint64_t    nbMissions;
+    uint64_t    nbOutcomes[4];                          // indexed by t_outcome
+    uint64_t    phaseHistogram[MISSION_MAX_PHASES + 1]; // missions ended after a given number of phases
+    uint64_t    costHistogram[MISSION_COST_BINS];       // final costs of the missions still on the map
+    uint64_t    totalPhases;
+} t_campaign_summary;
+
+/**
+ * @brief Function to get the strategy of the planner : the best sequence of planBest
+ * @param map : the map (unused, the planner holds it)
+ * @param loc : the localisation of the robot
+ * @param draw : the moves drawn
+ * @param nbDraw : the number of moves drawn
+ * @param nbChoose : the maximal number of moves to choose
+ * @param chosen : array receiving the moves
+ * @param ctx : pointer to the t_planner
+ * @return the number of moves chosen
+ */
+int plannerStrategy(t_map, t_localisation, const t_move *, int, int, t_move *, void *);
+
+/**
+ * @brief Function to create the parameters of missions planned by a planner
+ * @param p_planner : pointer to the planner
+ * @param nbDraw : the number of moves drawn per phase
+ * @param nbChoose : the number of moves chosen per phase
+ * @param maxPhases : the maximal number of phases (at most MISSION_MAX_PHASES)
+ * @return the parameters
+ */
+t_mission_config createMissionConfig(t_planner *, int, int, int);
+
+/**
+ * @brief Function to draw the start localisation of a mission : a random cell that is not a crevasse
+ * @param map : the map
+ * @param seed : the seed of the mission
+ * @return the localisation
+ */
+t_localisation drawStartLocalisation(t_map, uint64_t);
+
+/**
+ * @brief Function to draw the moves of a phase of a mission
+ * the draw only depends on the seed and the phase, so strategies see the same draws
+ * @param seed : the seed of the mission
+ * @param phase : the phase
+ * @param draw : array receiving the moves
+ * @param nbDraw : the number of moves to draw
+ * @return none
+ */
+void drawPhaseMoves(uint64_t, int, t_move *, int);
+
+/**
+ * @brief Function to simulate a mission : each phase draws moves, the strategy chooses them and they are
+ * applied with updateLocalisation until the base station, a crevasse or the edge of the map is reached
+ * (with a real-time context, each phase is measured and checked by rtBeginPhase / rtEndPhase)
+ * @param p_config : pointer to the parameters
+ * @param seed : the seed of the mission
+ * @return the record of the mission
+ */
+t_mission_record simulateMission(const t_mission_config *, uint64_t);
+
+/**
+ * @brief Function to initialise an empty summary of a seed range
+ * @param seed_begin : the first seed
+ * @param seed_end : the seed after the last one
+ * @return the summary
+ */
+t_campaign_summary createCampaignSummary(uint64_t, uint64_t);
+
+/**
+ * @brief Function to add a mission to a summary
+ * @param p_summary : pointer to the summary
+ * @param p_record : pointer to the record of the mission
+ * @return none
+ */
+void addToCampaignSummary(t_campaign_summary *, const t_mission_record *);
+
+/**
+ * @brief Function to merge a summary into another, their seed ranges must be adjacent
+ * @param p_summary : pointer to the summary receiving the merge
+ * @param p_other : pointer to the summary of the following seeds
+ * @return none
+ */
+void mergeCampaignSummaries(t_campaign_summary *, const t_campaign_summary *);
+
+/**
+ * @brief Function to save a summary in a binary file
+ * @param p_summary : pointer to the summary
+ * @param filename : the name of the file
+ * @return none
+ */
+void saveCampaignSummary(const t_campaign_summary *, char *);
+
+/**
+ * @brief Function to load a summary from a binary file
+ * @param filename : the name of the file
+ * @param p_summary : pointer to the summary receiving the file
+ * @return 1 if the file is a complete summary, 0 otherwise
+ */
+int loadCampaignSummary(char *, t_campaign_summary *);
+
+/**
+ * @brief Function to run the missions of a seed range in the current process
+ * @param p_config : pointer to the parameters
+ * @param seed_begin : the first seed
+ * @param seed_end : the seed after the last one
+ * @param results : the name of the results file to write, NULL for none
+ * @return the summary of the missions
+ */
+t_campaign_summary runCampaign(const t_mission_config *, uint64_t, uint64_t, char *);
+
+/**
+ * @brief Function to run the missions of a seed range as shards in separate processes, then merge them
+ * shard i writes <prefix>.<i>.sum and <prefix>.<i>.res; a shard that crashes is run again once;
+ * the merged summary and <prefix>.res are identical to those of runCampaign on the whole range
+ * @param p_config : pointer to the parameters
+ * @param seed_begin : the first seed
+ * @param seed_end : the seed after the last one
+ * @param nbShards : the number of processes
+ * @param prefix : the prefix of the files
+ * @return the merged summary
+ */
+t_campaign_summary runShardedCampaign(const t_mission_config *, uint64_t, uint64_t, int, char *);
+
+/**
+ * @brief Function to merge the files of the shards of a campaign
+ * @param prefix : the prefix of the files
+ * @param nbShards : the number of shards
+ * @return the merged summary, <prefix>.res receives the records of all the shards in seed order
+ */
+t_campaign_summary mergeCampaignShards(char *, int);
+
+#endif //UNTITLED1_MISSION_H
@@ -0,0 +1,400 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cpu.h"
+#include "mosaic.h"
+#include "queue.h"
+#include "soilscan.h"
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to get the cost cell of a position of a mosaic, in the costs of its tile
+ * @param p_mosaic : pointer to the mosaic
+ * @param pos : the position in the mosaic
+ * @return pointer to the cost
+ */
+int *getMosaicCostCell(const t_mosaic *, t_position);
+
+/**
+ * @brief function to get the minimal cost of the neighbours of a position of a mosaic
+ * @param p_mosaic : pointer to the mosaic
+ * @param pos : the position in the mosaic
+ * @return the minimal cost, COST_UNDEF if no neighbour is reached
+ */
+int getMosaicMinNeighbour(const t_mosaic *, t_position);
+
+/**
+ * @brief function to enqueue a position, the queue doubling when it is full
+ * @param p_queue : pointer to the queue
+ * @param pos : the position
+ * @return none
+ */
+void enqueueGrowing(t_queue *, t_position);
+
+/**
+ * @brief function to get the first base station of a mosaic, row by row, from the summaries of the tiles
+ * @param p_mosaic : pointer to the mosaic
+ * @return the position of the base station in the mosaic
+ */
+t_position getMosaicBaseStation(const t_mosaic *);
+
+/**
+ * @brief function to compute the costs of a mosaic from its base station, as calculateCosts does for a map
+ * @param p_mosaic : pointer to the mosaic
+ * @param baseStation : the position of the base station in the mosaic
+ * @return none
+ */
+void calculateMosaicBfs(t_mosaic *, t_position);
+
+/**
+ * @brief function to compare two false crevasses (see removeMosaicFalseCrevasses), for qsort
+ * @param a : pointer to the first key
+ * @param b : pointer to the second key
+ * @return <0, 0 or >0
+ */
+int compareMosaicCrevasses(const void *, const void *);
+
+/**
+ * @brief function to lower the false crevasses of a mosaic, as removeFalseCrevasses does for a map
+ * @param p_mosaic : pointer to the mosaic
+ * @return none
+ */
+void removeMosaicFalseCrevasses(t_mosaic *);
+
+/* definition of local functions */
+
+int *getMosaicCostCell(const t_mosaic *p_mosaic, t_position pos)
+{
+    t_position local;
+    t_map *p_tile = getMosaicTile(p_mosaic, pos, &local);
+    return &p_tile->costs[local.y][local.x];
+}
+
+int getMosaicMinNeighbour(const t_mosaic *p_mosaic, t_position pos)
+{
+    t_position around[4] = {LEFT(pos), RIGHT(pos), UP(pos), DOWN(pos)};
+    int min_cost = COST_UNDEF;
+    for (int i = 0; i < 4; i++)
+    {
+        if (isValidLocalisation(around[i], p_mosaic->x_max, p_mosaic->y_max))
+        {
+            int cost = *getMosaicCostCell(p_mosaic, around[i]);
+            min_cost = (cost < min_cost) ? cost : min_cost;
+        }
+    }
+    return min_cost;
+}
+
+void enqueueGrowing(t_queue *p_queue, t_position pos)
+{
+    if (p_queue->last - p_queue->first == p_queue->size)
+    {
+        // the values are moved in order to the start of a queue twice as large
+        int nb = p_queue->size;
+        t_position *values = (t_position *)malloc(2 * nb * sizeof(t_position));
+        for (int i = 0; i < nb; i++)
+        {
+            values[i] = p_queue->values[(p_queue->first + i) % nb];
+        }
+        free(p_queue->values);
+        p_queue->values = values;
+        p_queue->size = 2 * nb;
+        p_queue->first = 0;
+        p_queue->last = nb;
+    }
+    enqueue(p_queue, pos);
+    return;
+}
+
+t_position getMosaicBaseStation(const t_mosaic *p_mosaic)
+{
+    // the first base station of a tile is its first one row by row : the first of the mosaic is the smallest
+    // of them by row then column of the mosaic
+    t_position best;
+    int found = 0;
+    for (int i = 0; i < p_mosaic->nbCols * p_mosaic->nbRows; i++)
+    {
+        t_soil_summary summary = p_mosaic->tiles[i].summary;
+        if (summary.nbBases < 0)
+        {
+            t_soil_scan scan = scanSoils(p_mosaic->tiles[i]);
+            summary = getSoilSummary(&scan);
+            freeSoilScan(&scan);
+        }
+        if (summary.nbBases == 0)
+        {
+            continue;
+        }
+        t_position pos;
+        pos.x = p_mosaic->col_x[i % p_mosaic->nbCols] + summary.base.x;
+        pos.y = p_mosaic->row_y[i / p_mosaic->nbCols] + summary.base.y;
+        if (!found || pos.y < best.y || (pos.y == best.y && pos.x < best.x))
+        {
+            best = pos;
+            found = 1;
+        }
+    }
+    if (!found)
+    {
+        fprintf(stderr, "Error: base station not found in the mosaic\n");
+        exit(1);
+    }
+    return best;
+}
+
+void calculateMosaicBfs(t_mosaic *p_mosaic, t_position baseStation)
+{
+    // the queue only holds the front of the search, it grows with it instead of taking the size of the mosaic
+    t_queue queue = createQueue(1024);
+    enqueue(&queue, baseStation);
+    while (queue.first != queue.last)
+    {
+        t_position pos = dequeue(&queue);
+        t_position local;
+        t_map *p_tile = getMosaicTile(p_mosaic, pos, &local);
+        t_soil soil = p_tile->soils[local.y][local.x];
+        int min_cost = getMosaicMinNeighbour(p_mosaic, pos);
+        p_tile->costs[local.y][local.x] = (soil == BASE_STATION) ? 0 : min_cost + getSoilCost(p_tile->soil_costs, soil);
+        // the neighbours not visited yet are marked and enqueued, in the order of calculateCosts
+        t_position around[4] = {LEFT(pos), RIGHT(pos), UP(pos), DOWN(pos)};
+        for (int i = 0; i < 4; i++)
+        {
+            if (!isValidLocalisation(around[i], p_mosaic->x_max, p_mosaic->y_max))
+            {
+                continue;
+            }
+            int *p_cost = getMosaicCostCell(p_mosaic, around[i]);
+            if (*p_cost == COST_UNDEF)
+            {
+                *p_cost = COST_UNDEF - 1;
+                enqueueGrowing(&queue, around[i]);
+            }
+        }
+    }
+    free(queue.values);
+    return;
+}
+
+int compareMosaicCrevasses(const void *a, const void *b)
+{
+    uint64_t ka = *(const uint64_t *)a, kb = *(const uint64_t *)b;
+    return (ka > kb) - (ka < kb);
+}
+
+void removeMosaicFalseCrevasses(t_mosaic *p_mosaic)
+{
+    // same passes as removeFalseCrevasses, the key of a cell being its cost then its cell in the mosaic; only
+    // the candidates are stored, in an array that grows with them
+    int threshold = p_mosaic->tiles[0].soil_costs->cost[CREVASSE];
+    int capacity = 1024;
+    uint64_t *candidates = (uint64_t *)malloc(capacity * sizeof(uint64_t));
+    int lowered = 1;
+    while (lowered)
+    {
+        int nbCandidates = 0;
+        for (int y = 0; y < p_mosaic->y_max; y++)
+        {
+            int r = p_mosaic->tile_row[y];
+            for (int c = 0; c < p_mosaic->nbCols; c++)
+            {
+                t_map tile = p_mosaic->tiles[r * p_mosaic->nbCols + c];
+                int ly = y - p_mosaic->row_y[r];
+                int min_cost = COST_UNDEF;
+                if (_kernels.rowMinFalseCrevasse(tile.soils[ly], tile.costs[ly], tile.x_max, threshold, &min_cost) < 0)
+                {
+                    continue;
+                }
+                for (int lx = 0; lx < tile.x_max; lx++)
+                {
+                    int cost = tile.costs[ly][lx];
+                    if (tile.soils[ly][lx] != CREVASSE && cost > threshold && cost < COST_UNDEF)
+                    {
+                        if (nbCandidates == capacity)
+                        {
+                            capacity *= 2;
+                            candidates = (uint64_t *)realloc(candidates, capacity * sizeof(uint64_t));
+                        }
+                        int cell = y * p_mosaic->x_max + p_mosaic->col_x[c] + lx;
+                        candidates[nbCandidates++] = ((uint64_t)cost << 32) | (uint64_t)cell;
+                    }
+                }
+            }
+        }
+        qsort(candidates, nbCandidates, sizeof(uint64_t), compareMosaicCrevasses);
+        lowered = 0;
+        for (int i = 0; i < nbCandidates; i++)
+        {
+            int cell = (int)(candidates[i] & 0xFFFFFFFFu);
+            t_position pos;
+            pos.x = cell % p_mosaic->x_max;
+            pos.y = cell / p_mosaic->x_max;
+            t_position local;
+            t_map *p_tile = getMosaicTile(p_mosaic, pos, &local);
+            int self_cost = getSoilCost(p_tile->soil_costs, p_tile->soils[local.y][local.x]);
+            int cost = getMosaicMinNeighbour(p_mosaic, pos) + self_cost;
+            if (cost < p_tile->costs[local.y][local.x])
+            {
+                p_tile->costs[local.y][local.x] = cost;
+                lowered = 1;
+            }
+        }
+    }
+    free(candidates);
+    return;
+}
+
+/* definitions of exported functions */
+
+t_mosaic createMosaic(t_map *tiles, int nbCols, int nbRows)
+{
+    assert(nbCols > 0 && nbRows > 0);
+    t_mosaic mosaic;
+    mosaic.tiles = tiles;
+    mosaic.nbCols = nbCols;
+    mosaic.nbRows = nbRows;
+    mosaic.owns_tiles = 0;
+    mosaic.col_x = (int *)malloc((nbCols + 1) * sizeof(int));
+    mosaic.row_y = (int *)malloc((nbRows + 1) * sizeof(int));
+    // the first row and column of tiles give the widths and heights, the other tiles must match them
+    mosaic.col_x[0] = 0;
+    for (int c = 0; c < nbCols; c++)
+    {
+        mosaic.col_x[c + 1] = mosaic.col_x[c] + tiles[c].x_max;
+    }
+    mosaic.row_y[0] = 0;
+    for (int r = 0; r < nbRows; r++)
+    {
+        mosaic.row_y[r + 1] = mosaic.row_y[r] + tiles[r * nbCols].y_max;
+    }
+    for (int r = 0; r < nbRows; r++)
+    {
+        for (int c = 0; c < nbCols; c++)
+        {
+            t_map tile = tiles[r * nbCols + c];
+            if (tile.x_max != tiles[c].x_max || tile.y_max != tiles[r * nbCols].y_max)
+            {
+                fprintf(stderr, "Error: tile (%d, %d) is %dx%d, its row and column need %dx%d\n", c, r,
+                        tile.x_max, tile.y_max, tiles[c].x_max, tiles[r * nbCols].y_max);
+                exit(1);
+            }
+        }
+    }
+    mosaic.x_max = mosaic.col_x[nbCols];
+    mosaic.y_max = mosaic.row_y[nbRows];
+    // direct lookup of the tile of a column or a row of the mosaic
+    mosaic.tile_col = (int *)malloc(mosaic.x_max * sizeof(int));
+    mosaic.tile_row = (int *)malloc(mosaic.y_max * sizeof(int));
+    for (int c = 0; c < nbCols; c++)
+    {
+        for (int x = mosaic.col_x[c]; x < mosaic.col_x[c + 1]; x++)
+        {
+            mosaic.tile_col[x] = c;
+        }
+    }
+    for (int r = 0; r < nbRows; r++)
+    {
+        for (int y = mosaic.row_y[r]; y < mosaic.row_y[r + 1]; y++)
+        {
+            mosaic.tile_row[y] = r;
+        }
+    }
+    return mosaic;
+}
+
+t_mosaic createMosaicFromFiles(char **filenames, int nbCols, int nbRows)
+{
+    t_map *tiles = (t_map *)malloc(nbCols * nbRows * sizeof(t_map));
+    for (int i = 0; i < nbCols * nbRows; i++)
+    {
+        tiles[i] = createMapSoilsFromFile(filenames[i]);
+    }
+    t_mosaic mosaic = createMosaic(tiles, nbCols, nbRows);
+    mosaic.owns_tiles = 1;
+    return mosaic;
+}
+
+void freeMosaic(t_mosaic *p_mosaic)
+{
+    if (p_mosaic->owns_tiles)
+    {
+        for (int i = 0; i < p_mosaic->nbCols * p_mosaic->nbRows; i++)
+        {
+            for (int y = 0; y < p_mosaic->tiles[i].y_max; y++)
+            {
+                free(p_mosaic->tiles[i].soils[y]);
+                free(p_mosaic->tiles[i].costs[y]);
+            }
+            free(p_mosaic->tiles[i].soils);
+            free(p_mosaic->tiles[i].costs);
+        }
+        free(p_mosaic->tiles);
+    }
+    free(p_mosaic->col_x);
+    free(p_mosaic->row_y);
+    free(p_mosaic->tile_col);
+    free(p_mosaic->tile_row);
+    p_mosaic->tiles = NULL;
+    return;
+}
+
+t_map *getMosaicTile(const t_mosaic *p_mosaic, t_position pos, t_position *p_local)
+{
+    assert(isValidLocalisation(pos, p_mosaic->x_max, p_mosaic->y_max));
+    int c = p_mosaic->tile_col[pos.x];
+    int r = p_mosaic->tile_row[pos.y];
+    p_local->x = pos.x - p_mosaic->col_x[c];
+    p_local->y = pos.y - p_mosaic->row_y[r];
+    return &p_mosaic->tiles[r * p_mosaic->nbCols + c];
+}
+
+t_soil getMosaicSoil(const t_mosaic *p_mosaic, t_position pos)
+{
+    t_position local;
+    t_map *p_tile = getMosaicTile(p_mosaic, pos, &local);
+    return p_tile->soils[local.y][local.x];
+}
+
+int getMosaicCost(const t_mosaic *p_mosaic, t_position pos)
+{
+    t_position local;
+    t_map *p_tile = getMosaicTile(p_mosaic, pos, &local);
+    return p_tile->costs[local.y][local.x];
+}
+
+void calculateMosaicCosts(t_mosaic *p_mosaic)
+{
+    // the costs are computed in the tiles, as the engine of the maps does for the map made of the tiles :
+    // the tiles have to share their soil costs
+    int nbTiles = p_mosaic->nbCols * p_mosaic->nbRows;
+    const t_soil_costs *p_costs = p_mosaic->tiles[0].soil_costs;
+    for (int i = 1; i < nbTiles; i++)
+    {
+        if (memcmp(p_mosaic->tiles[i].soil_costs->cost, p_costs->cost, sizeof(p_costs->cost)) != 0)
+        {
+            fprintf(stderr, "Error: tile %d of the mosaic has other soil costs than the first tile\n", i);
+            exit(1);
+        }
+    }
+    t_position baseStation = getMosaicBaseStation(p_mosaic);
+    for (int i = 0; i < nbTiles; i++)
+    {
+        t_map tile = p_mosaic->tiles[i];
+        for (int y = 0; y < tile.y_max; y++)
+        {
+            for (int x = 0; x < tile.x_max; x++)
+            {
+                tile.costs[y][x] = (tile.soils[y][x] == BASE_STATION) ? 0 : COST_UNDEF;
+            }
+        }
+    }
+    calculateMosaicBfs(p_mosaic, baseStation);
+    removeMosaicFalseCrevasses(p_mosaic);
+    return;
+}
@@ -0,0 +1,90 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_MOSAIC_H
+#define UNTITLED1_MOSAIC_H
+
+#include "loc.h"
+#include "map.h"
+
+/**
+ * @brief Structure for a mosaic : a grid of adjacent tiles seen as one large map, without copy of the tiles
+ * all the tiles of a row of the grid have the same height, all the tiles of a column the same width
+ */
+typedef struct s_mosaic
+{
+    t_map   *tiles;     // nbCols x nbRows tiles, row by row
+    int     nbCols;
+    int     nbRows;
+    int     *col_x;     // first column of each column of tiles, col_x[nbCols] = x_max
+    int     *row_y;     // first row of each row of tiles, row_y[nbRows] = y_max
+    int     *tile_col;  // column of tiles of each column of the mosaic
+    int     *tile_row;  // row of tiles of each row of the mosaic
+    int     x_max;
+    int     y_max;
+    int     owns_tiles; // 1 if the tiles were loaded by the mosaic and are freed with it
+} t_mosaic;
+
+/**
+ * @brief Function to create a mosaic of tiles (the tiles are referenced, not copied)
+ * @param tiles : the nbCols x nbRows tiles, row by row
+ * @param nbCols : the number of columns of tiles
+ * @param nbRows : the number of rows of tiles
+ * @return the mosaic
+ */
+t_mosaic createMosaic(t_map *, int, int);
+
+/**
+ * @brief Function to create a mosaic from map files, whose costs are not computed
+ * @param filenames : the nbCols x nbRows files, row by row
+ * @param nbCols : the number of columns of tiles
+ * @param nbRows : the number of rows of tiles
+ * @return the mosaic
+ */
+t_mosaic createMosaicFromFiles(char **, int, int);
+
+/**
+ * @brief Function to free a mosaic (and its tiles if it loaded them)
+ * @param p_mosaic : pointer to the mosaic
+ * @return none
+ */
+void freeMosaic(t_mosaic *);
+
+/**
+ * @brief Function to get the tile of a position of a mosaic
+ * @param p_mosaic : pointer to the mosaic
+ * @param pos : the position in the mosaic
+ * @param p_local : pointer receiving the position in the tile
+ * @return pointer to the tile
+ */
+t_map *getMosaicTile(const t_mosaic *, t_position, t_position *);
+
+/**
+ * @brief Function to get the soil of a position of a mosaic
+ * @param p_mosaic : pointer to the mosaic
+ * @param pos : the position in the mosaic
+ * @return the soil
+ */
+t_soil getMosaicSoil(const t_mosaic *, t_position);
+
+/**
+ * @brief Function to get the cost of a position of a mosaic
+ * @param p_mosaic : pointer to the mosaic
+ * @param pos : the position in the mosaic
+ * @return the cost
+ */
+int getMosaicCost(const t_mosaic *, t_position);
+
+/**
+ * @brief Function to compute the costs of a mosaic, written in the cost arrays of its tiles
+ * the engine of the maps (see setMapSoilCosts) is run over the tiles themselves, without building the map made
+ * of them : the costs are the ones createMapFromFile gives for that map, false crevasses removed; the tiles must
+ * have the same soil costs and the mosaic one base station at least, the first one row by row being the source
+ * (the shortest-path tree of critical.h is a Dijkstra that never crosses crevasses, its costs can differ)
+ * @param p_mosaic : pointer to the mosaic
+ * @return none
+ */
+void calculateMosaicCosts(t_mosaic *);
+
+#endif //UNTITLED1_MOSAIC_H
@@ -3,6 +3,7 @@
 //
 
 #include "moves.h"
+#include "tables.h"
 
 /* prototypes of local functions */
 /* local functions are used only in this file, as helper functions */
@@ -27,22 +28,7 @@ t_localisation translate(t_localisation , t_move);
 
 t_orientation rotate(t_orientation ori, t_move move)
 {
-    int rst;
-    switch (move)
-    {
-        case T_LEFT:
-            rst=3;
-            break;
-        case T_RIGHT:
-            rst=1;
-            break;
-        case U_TURN:
-            rst=2;
-            break;
-        default:
-            break;
-    }
-    return (ori+rst)%4;
+    return _move_rotation[ori][move];
 }
 
 t_localisation translate(t_localisation loc, t_move move)
@@ -52,85 +38,7 @@ t_localisation translate(t_localisation loc, t_move move)
      *  - y grows to the bottom with step of +1
      *  - the origin (x=0, y=0) is at the top left corner
      */
-    t_position res = loc.pos;
-    switch (move) {
-        case F_10:
-            switch (loc.ori) {
-                case NORTH:
-                    res.y = loc.pos.y - 1;
-                    break;
-                case EAST:
-                    res.x = loc.pos.x + 1;
-                    break;
-                case SOUTH:
-                    res.y = loc.pos.y + 1;
-                    break;
-                case WEST:
-                    res.x = loc.pos.x - 1;
-                    break;
-                default:
-                    break;
-            }
-            break;
-        case F_20:
-            switch (loc.ori) {
-                case NORTH:
-                    res.y = loc.pos.y - 2;
-                    break;
-                case EAST:
-                    res.x = loc.pos.x + 2;
-                    break;
-                case SOUTH:
-                    res.y = loc.pos.y + 2;
-                    break;
-                case WEST:
-                    res.x = loc.pos.x - 2;
-                    break;
-                default:
-                    break;
-            }
-            break;
-        case F_30:
-            switch (loc.ori) {
-                case NORTH:
-                    res.y = loc.pos.y - 3;
-                    break;
-                case EAST:
-                    res.x = loc.pos.x + 3;
-                    break;
-                case SOUTH:
-                    res.y = loc.pos.y + 3;
-                    break;
-                case WEST:
-                    res.x = loc.pos.x - 3;
-                    break;
-                default:
-                    break;
-            }
-            break;
-        case B_10:
-            switch (loc.ori) {
-                case NORTH:
-                    res.y = loc.pos.y + 1;
-                    break;
-                case EAST:
-                    res.x = loc.pos.x - 1;
-                    break;
-                case SOUTH:
-                    res.y = loc.pos.y - 1;
-                    break;
-                case WEST:
-                    res.x = loc.pos.x + 1;
-                    break;
-                default:
-                    break;
-            }
-            break;
-        default:
-            break;
-    }
-        return loc_init(res.x, res.y, loc.ori);
-
+    return loc_init(loc.pos.x + _move_delta[loc.ori][move][0], loc.pos.y + _move_delta[loc.ori][move][1], loc.ori);
 }
 
 /* definitions of exported functions */
@@ -153,3 +61,8 @@ void updateLocalisation(t_localisation *p_loc, t_move m)
     *p_loc = move(*p_loc, m);
     return;
 }
+
+int getMoveReach(t_move move)
+{
+    return _move_reach[move];
+}
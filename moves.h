@@ -27,6 +27,11 @@ typedef enum e_move
     U_TURN
 } t_move;
 
+/**
+ * @brief Number of different moves
+ */
+#define NB_MOVE_TYPES (U_TURN + 1)
+
 /**
  * @brief function to get a t_move as a string
  * @param move : the move to convert
@@ -50,4 +55,11 @@ t_localisation move(t_localisation, t_move);
  */
 void updateLocalisation(t_localisation *, t_move);
 
+/**
+ * @brief function to get the number of cells a move can translate the robot
+ * @param move : the move
+ * @return the number of cells covered by the move (0 for rotations)
+ */
+int getMoveReach(t_move);
+
 #endif //UNTITLED1_MOVES_H
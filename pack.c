@@ -0,0 +1,280 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "pack.h"
+
+/** layout of a pack file (little endian) :
+ * - header : "MARCPAK1", version (u32), number of maps (u32), index offset (u64), number of slots (u64)
+ * - for each map, aligned on 64 bytes : its name ('\0' ended), then its soils and its costs (i32, row by row)
+ * - index : the slots (t_pack_slot), a power of 2 of them, at least twice the number of maps
+ */
+#define PACK_MAGIC "MARCPAK1"
+#define PACK_VERSION 1
+#define PACK_HEADER_SIZE 32
+#define PACK_ALIGN 64
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to hash the name of a map (FNV-1a)
+ * @param name : the name
+ * @return the hash
+ */
+uint64_t hashPackName(const char *);
+
+/**
+ * @brief function to write a buffer at the end of a pack being written, exiting on error
+ * @param p_writer : pointer to the writer
+ * @param buffer : the buffer
+ * @param size : the size of the buffer
+ * @return none
+ */
+void writePackBytes(t_pack_writer *, const void *, size_t);
+
+/**
+ * @brief function to pad a pack being written with zeros up to a multiple of an alignment
+ * @param p_writer : pointer to the writer
+ * @param alignment : the alignment
+ * @return none
+ */
+void padPack(t_pack_writer *, uint64_t);
+
+/* definition of local functions */
+
+uint64_t hashPackName(const char *name)
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (; *name != '\0'; name++)
+    {
+        hash = (hash ^ (unsigned char)*name) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+void writePackBytes(t_pack_writer *p_writer, const void *buffer, size_t size)
+{
+    if (size > 0 && fwrite(buffer, size, 1, p_writer->file) != 1)
+    {
+        fprintf(stderr, "Error: cannot write file %s\n", p_writer->filename);
+        exit(1);
+    }
+    p_writer->end += size;
+    return;
+}
+
+void padPack(t_pack_writer *p_writer, uint64_t alignment)
+{
+    static const char zeros[PACK_ALIGN] = {0};
+    writePackBytes(p_writer, zeros, (alignment - p_writer->end % alignment) % alignment);
+    return;
+}
+
+/* definitions of exported functions */
+
+t_pack_writer createPackWriter(char *filename)
+{
+    t_pack_writer writer;
+    writer.file = fopen(filename, "wb");
+    if (writer.file == NULL)
+    {
+        fprintf(stderr, "Error: cannot open file %s\n", filename);
+        exit(1);
+    }
+    writer.filename = filename;
+    writer.end = 0;
+    writer.nbMaps = 0;
+    writer.capacity = 64;
+    writer.entries = (t_pack_slot *)malloc(writer.capacity * sizeof(t_pack_slot));
+    writer.names = (char **)malloc(writer.capacity * sizeof(char *));
+    // the header is written again on close, once the index is known
+    char header[PACK_HEADER_SIZE] = {0};
+    writePackBytes(&writer, header, PACK_HEADER_SIZE);
+    return writer;
+}
+
+void addPackMap(t_pack_writer *p_writer, char *name, t_map map, int withCosts)
+{
+    uint64_t hash = hashPackName(name);
+    for (int i = 0; i < p_writer->nbMaps; i++)
+    {
+        if (p_writer->entries[i].hash == hash && strcmp(p_writer->names[i], name) == 0)
+        {
+            fprintf(stderr, "Error: map %s is already in the pack %s\n", name, p_writer->filename);
+            exit(1);
+        }
+    }
+    if (p_writer->nbMaps == p_writer->capacity)
+    {
+        p_writer->capacity *= 2;
+        p_writer->entries = (t_pack_slot *)realloc(p_writer->entries, p_writer->capacity * sizeof(t_pack_slot));
+        p_writer->names = (char **)realloc(p_writer->names, p_writer->capacity * sizeof(char *));
+    }
+    p_writer->names[p_writer->nbMaps] = strdup(name);
+    t_pack_slot *p_entry = &p_writer->entries[p_writer->nbMaps++];
+    padPack(p_writer, PACK_ALIGN);
+    p_entry->hash = hash;
+    p_entry->name = p_writer->end;
+    p_entry->x_max = (uint32_t)map.x_max;
+    p_entry->y_max = (uint32_t)map.y_max;
+    writePackBytes(p_writer, name, strlen(name) + 1);
+    padPack(p_writer, PACK_ALIGN);
+    p_entry->soils = p_writer->end;
+    for (int i = 0; i < map.y_max; i++)
+    {
+        writePackBytes(p_writer, map.soils[i], map.x_max * sizeof(t_soil));
+    }
+    p_entry->costs = 0;
+    if (withCosts)
+    {
+        padPack(p_writer, PACK_ALIGN);
+        p_entry->costs = p_writer->end;
+        for (int i = 0; i < map.y_max; i++)
+        {
+            writePackBytes(p_writer, map.costs[i], map.x_max * sizeof(int));
+        }
+    }
+    return;
+}
+
+void closePackWriter(t_pack_writer *p_writer)
+{
+    uint64_t nbSlots = 1;
+    while (nbSlots < 2 * (uint64_t)p_writer->nbMaps)
+    {
+        nbSlots *= 2;
+    }
+    t_pack_slot *slots = (t_pack_slot *)calloc(nbSlots, sizeof(t_pack_slot));
+    for (int i = 0; i < p_writer->nbMaps; i++)
+    {
+        uint64_t s = p_writer->entries[i].hash & (nbSlots - 1);
+        while (slots[s].name != 0)
+        {
+            s = (s + 1) & (nbSlots - 1);
+        }
+        slots[s] = p_writer->entries[i];
+    }
+    padPack(p_writer, PACK_ALIGN);
+    uint64_t index = p_writer->end;
+    writePackBytes(p_writer, slots, nbSlots * sizeof(t_pack_slot));
+    free(slots);
+
+    char header[PACK_HEADER_SIZE] = {0};
+    uint32_t version = PACK_VERSION;
+    uint32_t nbMaps = (uint32_t)p_writer->nbMaps;
+    memcpy(header, PACK_MAGIC, 8);
+    memcpy(header + 8, &version, 4);
+    memcpy(header + 12, &nbMaps, 4);
+    memcpy(header + 16, &index, 8);
+    memcpy(header + 24, &nbSlots, 8);
+    if (fseek(p_writer->file, 0, SEEK_SET) != 0 || fwrite(header, PACK_HEADER_SIZE, 1, p_writer->file) != 1
+        || fclose(p_writer->file) != 0)
+    {
+        fprintf(stderr, "Error: cannot write file %s\n", p_writer->filename);
+        exit(1);
+    }
+    for (int i = 0; i < p_writer->nbMaps; i++)
+    {
+        free(p_writer->names[i]);
+    }
+    free(p_writer->names);
+    free(p_writer->entries);
+    p_writer->names = NULL;
+    p_writer->entries = NULL;
+    p_writer->file = NULL;
+    return;
+}
+
+t_pack openPack(char *filename)
+{
+    t_pack pack;
+    int fd = open(filename, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0)
+    {
+        fprintf(stderr, "Error: cannot open file %s\n", filename);
+        exit(1);
+    }
+    pack.size = (size_t)st.st_size;
+    if (pack.size < PACK_HEADER_SIZE)
+    {
+        fprintf(stderr, "Error: %s is not a pack file\n", filename);
+        exit(1);
+    }
+    pack.data = (char *)mmap(NULL, pack.size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (pack.data == MAP_FAILED)
+    {
+        fprintf(stderr, "Error: cannot map file %s\n", filename);
+        exit(1);
+    }
+    uint32_t nbMaps;
+    uint64_t index;
+    memcpy(&nbMaps, pack.data + 12, 4);
+    memcpy(&index, pack.data + 16, 8);
+    memcpy(&pack.nbSlots, pack.data + 24, 8);
+    if (memcmp(pack.data, PACK_MAGIC, 8) != 0 || pack.nbSlots == 0 || (pack.nbSlots & (pack.nbSlots - 1)) != 0
+        || index % PACK_ALIGN != 0 || index + pack.nbSlots * sizeof(t_pack_slot) > pack.size)
+    {
+        fprintf(stderr, "Error: %s is not a complete pack file\n", filename);
+        exit(1);
+    }
+    pack.nbMaps = (int)nbMaps;
+    pack.slots = (const t_pack_slot *)(pack.data + index);
+    return pack;
+}
+
+void closePack(t_pack *p_pack)
+{
+    munmap(p_pack->data, p_pack->size);
+    p_pack->data = NULL;
+    p_pack->slots = NULL;
+    p_pack->size = 0;
+    return;
+}
+
+int getPackMap(const t_pack *p_pack, char *name, t_map *p_map)
+{
+    uint64_t hash = hashPackName(name);
+    uint64_t s = hash & (p_pack->nbSlots - 1);
+    while (p_pack->slots[s].name != 0)
+    {
+        const t_pack_slot *p_slot = &p_pack->slots[s];
+        if (p_slot->hash == hash && strcmp(p_pack->data + p_slot->name, name) == 0)
+        {
+            p_map->x_max = (int)p_slot->x_max;
+            p_map->y_max = (int)p_slot->y_max;
+            p_map->soil_costs = &_default_soil_costs;
+            p_map->summary.nbBases = -1;
+            p_map->soils = (t_soil **)malloc(p_map->y_max * sizeof(t_soil *));
+            p_map->costs = (p_slot->costs != 0) ? (int **)malloc(p_map->y_max * sizeof(int *)) : NULL;
+            for (int i = 0; i < p_map->y_max; i++)
+            {
+                p_map->soils[i] = (t_soil *)(p_pack->data + p_slot->soils) + (size_t)i * p_map->x_max;
+                if (p_map->costs != NULL)
+                {
+                    p_map->costs[i] = (int *)(p_pack->data + p_slot->costs) + (size_t)i * p_map->x_max;
+                }
+            }
+            return 1;
+        }
+        s = (s + 1) & (p_pack->nbSlots - 1);
+    }
+    return 0;
+}
+
+void freePackMap(t_map *p_map)
+{
+    free(p_map->soils);
+    free(p_map->costs);
+    p_map->soils = NULL;
+    p_map->costs = NULL;
+    return;
+}
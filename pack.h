@@ -0,0 +1,107 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_PACK_H
+#define UNTITLED1_PACK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "map.h"
+
+/**
+ * @brief Structure for a slot of the index of a pack : open addressing on the hash of the names
+ */
+typedef struct s_pack_slot
+{
+    uint64_t    hash;
+    uint64_t    name;   // offset of the name (ended by '\0'), 0 for an empty slot
+    uint64_t    soils;  // offset of the soils, one int32 per cell, row by row
+    uint64_t    costs;  // offset of the costs, 0 if the pack has no costs for the map
+    uint32_t    x_max;
+    uint32_t    y_max;
+} t_pack_slot;
+
+/**
+ * @brief Structure for a pack being written
+ */
+typedef struct s_pack_writer
+{
+    FILE        *file;
+    char        *filename;
+    uint64_t    end;        // offset of the next section
+    t_pack_slot *entries;   // one per map added, hashed into the index on close
+    char        **names;    // names of the maps added, to refuse duplicates
+    int         nbMaps;
+    int         capacity;
+} t_pack_writer;
+
+/**
+ * @brief Structure for a pack mapped in memory
+ */
+typedef struct s_pack
+{
+    char                *data;
+    size_t              size;
+    const t_pack_slot   *slots;
+    uint64_t            nbSlots;    // a power of 2
+    int                 nbMaps;
+} t_pack;
+
+/**
+ * @brief Function to create a pack file
+ * @param filename : the name of the file
+ * @return the writer
+ */
+t_pack_writer createPackWriter(char *);
+
+/**
+ * @brief Function to add a map to a pack
+ * @param p_writer : pointer to the writer
+ * @param name : the name of the map, unique in the pack
+ * @param map : the map
+ * @param withCosts : 1 to store the costs of the map, 0 for its soils only
+ * @return none
+ */
+void addPackMap(t_pack_writer *, char *, t_map, int);
+
+/**
+ * @brief Function to write the index of a pack and close it
+ * @param p_writer : pointer to the writer
+ * @return none
+ */
+void closePackWriter(t_pack_writer *);
+
+/**
+ * @brief Function to map a pack in memory (pages are private : writing to a map does not change the file)
+ * @param filename : the name of the file
+ * @return the pack
+ */
+t_pack openPack(char *);
+
+/**
+ * @brief Function to unmap a pack, the maps taken from it must not be used any more
+ * @param p_pack : pointer to the pack
+ * @return none
+ */
+void closePack(t_pack *);
+
+/**
+ * @brief Function to find a map of a pack by name
+ * the rows of the map point into the pack, only the arrays of rows are allocated (see freePackMap)
+ * @param p_pack : pointer to the pack
+ * @param name : the name of the map
+ * @param p_map : pointer receiving the map, its costs are NULL if the pack has none for it
+ * @return 1 if the map was found, 0 otherwise
+ */
+int getPackMap(const t_pack *, char *, t_map *);
+
+/**
+ * @brief Function to free the arrays of rows of a map taken from a pack
+ * @param p_map : pointer to the map
+ * @return none
+ */
+void freePackMap(t_map *);
+
+#endif //UNTITLED1_PACK_H
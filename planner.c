@@ -0,0 +1,363 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cpu.h"
+#include "planner.h"
+
+/**
+ * @brief Structure for the state of a top-k search
+ * the plans array of the caller is used as a bounded max-heap : plans[0] is the k-th best plan so far
+ */
+typedef struct s_plan_search
+{
+    const t_planner *planner;
+    t_move          draw[PLAN_MAX_MOVES];   // sorted by decreasing reach, equal moves adjacent
+    int             used[PLAN_MAX_MOVES];
+    int             nbDraw;
+    int             nbChoose;
+    t_move          current[PLAN_MAX_MOVES];
+    t_plan          *heap;
+    int             heap_size;
+    int             k;
+    const atomic_int *cancel;   // NULL when the search cannot be cancelled
+    int             cancelled;
+    t_plan_filter   filter;     // NULL when every cell is accepted
+    void            *filter_ctx;
+} t_plan_search;
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to compare two plans
+ * @param a : pointer to the first plan
+ * @param b : pointer to the second plan
+ * @return a negative value if a is better than b, 0 if they are equal, a positive value otherwise
+ */
+int comparePlans(const t_plan *, const t_plan *);
+
+/**
+ * @brief function to restore the max-heap property from a position downwards
+ * @param heap : the heap
+ * @param size : the number of plans in the heap
+ * @param i : the position to sift down
+ * @return none
+ */
+void planHeapSiftDown(t_plan *, int, int);
+
+/**
+ * @brief function to offer a candidate plan to the bounded heap of a search
+ * @param p_search : pointer to the search
+ * @param p_plan : pointer to the candidate
+ * @return none
+ */
+void planHeapOffer(t_plan_search *, const t_plan *);
+
+/**
+ * @brief function to get the largest translation the unused moves of a search can still do
+ * @param p_search : pointer to the search
+ * @param nbLeft : the number of moves that can still be chosen
+ * @return the reach in cells
+ */
+int remainingReach(const t_plan_search *, int);
+
+/**
+ * @brief function to get a lower bound of the cost reachable from a position
+ * @param p_planner : pointer to the planner
+ * @param pos : the position
+ * @param reach : the translation left (in cells)
+ * @return the lower bound
+ */
+int reachLowerBound(const t_planner *, t_position, int);
+
+/**
+ * @brief recursive depth-first enumeration of the ordered subsets of the draw
+ * @param p_search : pointer to the search
+ * @param loc : the localisation after the moves already chosen
+ * @param depth : the number of moves already chosen
+ * @return none
+ */
+void searchPlans(t_plan_search *, t_localisation, int);
+
+/**
+ * @brief function to run a top-k search (see planTopKCancellable and planTopKFiltered)
+ * @param p_search : pointer to the search, whose planner, heap, k, cancel and filter are set
+ * @param loc : the localisation of the robot at the start of the phase
+ * @param draw : the moves drawn for the phase
+ * @param nbDraw : the number of moves drawn
+ * @param nbChoose : the maximal number of moves to choose
+ * @return the number of plans written in the heap of the search, -1 if the search was cancelled
+ */
+int runPlanSearch(t_plan_search *, t_localisation, const t_move *, int, int);
+
+/* definition of local functions */
+
+int comparePlans(const t_plan *a, const t_plan *b)
+{
+    if (a->cost != b->cost)
+    {
+        return (a->cost < b->cost) ? -1 : 1;
+    }
+    if (a->nbMoves != b->nbMoves)
+    {
+        return (a->nbMoves < b->nbMoves) ? -1 : 1;
+    }
+    return memcmp(a->moves, b->moves, a->nbMoves * sizeof(t_move));
+}
+
+void planHeapSiftDown(t_plan *heap, int size, int i)
+{
+    while (1)
+    {
+        int worst = i;
+        int left = 2 * i + 1;
+        int right = left + 1;
+        if (left < size && comparePlans(&heap[left], &heap[worst]) > 0)
+        {
+            worst = left;
+        }
+        if (right < size && comparePlans(&heap[right], &heap[worst]) > 0)
+        {
+            worst = right;
+        }
+        if (worst == i)
+        {
+            return;
+        }
+        t_plan tmp = heap[i];
+        heap[i] = heap[worst];
+        heap[worst] = tmp;
+        i = worst;
+    }
+}
+
+void planHeapOffer(t_plan_search *p_search, const t_plan *p_plan)
+{
+    t_plan *heap = p_search->heap;
+    if (p_search->heap_size < p_search->k)
+    {
+        // sift up the new plan
+        int i = p_search->heap_size++;
+        heap[i] = *p_plan;
+        while (i > 0 && comparePlans(&heap[(i - 1) / 2], &heap[i]) < 0)
+        {
+            t_plan tmp = heap[i];
+            heap[i] = heap[(i - 1) / 2];
+            heap[(i - 1) / 2] = tmp;
+            i = (i - 1) / 2;
+        }
+    }
+    else if (comparePlans(p_plan, &heap[0]) < 0)
+    {
+        // the candidate replaces the k-th best plan
+        heap[0] = *p_plan;
+        planHeapSiftDown(heap, p_search->heap_size, 0);
+    }
+    return;
+}
+
+int remainingReach(const t_plan_search *p_search, int nbLeft)
+{
+    // the draw is sorted by decreasing reach : the first unused moves are the longest ones
+    int reach = 0;
+    for (int i = 0; i < p_search->nbDraw && nbLeft > 0; i++)
+    {
+        if (!p_search->used[i])
+        {
+            reach += getMoveReach(p_search->draw[i]);
+            nbLeft--;
+        }
+    }
+    return reach;
+}
+
+int reachLowerBound(const t_planner *p_planner, t_position pos, int reach)
+{
+    // beyond the tables, nothing better than the base station (cost 0) can be guaranteed
+    if (reach > p_planner->max_reach)
+    {
+        return 0;
+    }
+    return p_planner->reach_min[reach][pos.y * p_planner->map.x_max + pos.x];
+}
+
+void searchPlans(t_plan_search *p_search, t_localisation loc, int depth)
+{
+    const t_map *map = &p_search->planner->map;
+    if (p_search->cancel != NULL && atomic_load_explicit(p_search->cancel, memory_order_relaxed))
+    {
+        p_search->cancelled = 1;
+        return;
+    }
+    for (int i = 0; i < p_search->nbDraw && !p_search->cancelled; i++)
+    {
+        // equal moves are interchangeable : only the first unused one is tried at a given depth
+        if (p_search->used[i] || (i > 0 && p_search->draw[i] == p_search->draw[i - 1] && !p_search->used[i - 1]))
+        {
+            continue;
+        }
+        t_localisation next = move(loc, p_search->draw[i]);
+        // leaving the map or falling into a crevasse ends the mission : the sequence is discarded
+        if (!isValidLocalisation(next.pos, map->x_max, map->y_max) || map->soils[next.pos.y][next.pos.x] == CREVASSE)
+        {
+            continue;
+        }
+        if (p_search->filter != NULL && !p_search->filter(next.pos, depth + 1, 0, p_search->filter_ctx))
+        {
+            continue;
+        }
+        p_search->current[depth] = p_search->draw[i];
+
+        if (p_search->filter == NULL || p_search->filter(next.pos, depth + 1, 1, p_search->filter_ctx))
+        {
+            t_plan candidate;
+            memcpy(candidate.moves, p_search->current, (depth + 1) * sizeof(t_move));
+            candidate.nbMoves = depth + 1;
+            candidate.cost = map->costs[next.pos.y][next.pos.x];
+            candidate.end = next;
+            planHeapOffer(p_search, &candidate);
+        }
+
+        if (map->soils[next.pos.y][next.pos.x] == BASE_STATION || depth + 1 >= p_search->nbChoose)
+        {
+            continue;
+        }
+        p_search->used[i] = 1;
+        // prune when no extension can beat the k-th best plan
+        int full = (p_search->heap_size == p_search->k);
+        t_plan bound;
+        bound.cost = reachLowerBound(p_search->planner, next.pos, remainingReach(p_search, p_search->nbChoose - depth - 1));
+        bound.nbMoves = depth + 2;
+        if (!full || bound.cost < p_search->heap[0].cost
+            || (bound.cost == p_search->heap[0].cost && bound.nbMoves <= p_search->heap[0].nbMoves))
+        {
+            searchPlans(p_search, next, depth + 1);
+        }
+        p_search->used[i] = 0;
+    }
+    return;
+}
+
+int runPlanSearch(t_plan_search *p_search, t_localisation loc, const t_move *draw, int nbDraw, int nbChoose)
+{
+    assert(nbDraw >= 0 && nbDraw <= PLAN_MAX_MOVES);
+    assert(p_search->k > 0);
+    p_search->nbDraw = nbDraw;
+    p_search->nbChoose = (nbChoose < nbDraw) ? nbChoose : nbDraw;
+    p_search->heap_size = 0;
+    p_search->cancelled = 0;
+    // insertion sort of the draw by decreasing reach, then by move
+    for (int i = 0; i < nbDraw; i++)
+    {
+        t_move m = draw[i];
+        int j = i;
+        while (j > 0 && (getMoveReach(p_search->draw[j - 1]) < getMoveReach(m)
+                         || (getMoveReach(p_search->draw[j - 1]) == getMoveReach(m) && p_search->draw[j - 1] > m)))
+        {
+            p_search->draw[j] = p_search->draw[j - 1];
+            j--;
+        }
+        p_search->draw[j] = m;
+        p_search->used[i] = 0;
+    }
+    if (p_search->nbChoose > 0)
+    {
+        searchPlans(p_search, loc, 0);
+    }
+    if (p_search->cancelled)
+    {
+        return -1;
+    }
+    // heap sort : the worst plan is moved to the end of the array at each step
+    t_plan *plans = p_search->heap;
+    for (int size = p_search->heap_size; size > 1; size--)
+    {
+        t_plan tmp = plans[0];
+        plans[0] = plans[size - 1];
+        plans[size - 1] = tmp;
+        planHeapSiftDown(plans, size - 1, 0);
+    }
+    return p_search->heap_size;
+}
+
+/* definitions of exported functions */
+
+t_planner createPlanner(t_map map, int max_reach)
+{
+    assert(max_reach >= 0);
+    t_planner planner;
+    int nbCells = map.x_max * map.y_max;
+    planner.map = map;
+    planner.max_reach = max_reach;
+    planner.reach_min = (int **)malloc((max_reach + 1) * sizeof(int *));
+    planner.reach_min[0] = (int *)malloc(nbCells * sizeof(int));
+    for (int i = 0; i < map.y_max; i++)
+    {
+        memcpy(planner.reach_min[0] + i * map.x_max, map.costs[i], map.x_max * sizeof(int));
+    }
+    // the ball of radius r is the union of the balls of radius r-1 around a cell and its neighbours
+    for (int r = 1; r <= max_reach; r++)
+    {
+        int *prev = planner.reach_min[r - 1];
+        int *cur = (int *)malloc(nbCells * sizeof(int));
+        for (int i = 0; i < map.y_max; i++)
+        {
+            int *row = prev + i * map.x_max;
+            _kernels.rowMin5((i > 0) ? row - map.x_max : NULL, row, (i < map.y_max - 1) ? row + map.x_max : NULL,
+                             cur + i * map.x_max, map.x_max);
+        }
+        planner.reach_min[r] = cur;
+    }
+    return planner;
+}
+
+void freePlanner(t_planner *p_planner)
+{
+    for (int r = 0; r <= p_planner->max_reach; r++)
+    {
+        free(p_planner->reach_min[r]);
+    }
+    free(p_planner->reach_min);
+    p_planner->reach_min = NULL;
+    return;
+}
+
+int planTopK(const t_planner *p_planner, t_localisation loc, const t_move *draw, int nbDraw, int nbChoose, t_plan *plans, int k)
+{
+    return planTopKCancellable(p_planner, loc, draw, nbDraw, nbChoose, plans, k, NULL);
+}
+
+int planTopKCancellable(const t_planner *p_planner, t_localisation loc, const t_move *draw, int nbDraw, int nbChoose,
+                        t_plan *plans, int k, const atomic_int *p_cancel)
+{
+    t_plan_search search;
+    search.planner = p_planner;
+    search.heap = plans;
+    search.k = k;
+    search.cancel = p_cancel;
+    search.filter = NULL;
+    search.filter_ctx = NULL;
+    return runPlanSearch(&search, loc, draw, nbDraw, nbChoose);
+}
+
+int planTopKFiltered(const t_planner *p_planner, t_localisation loc, const t_move *draw, int nbDraw, int nbChoose,
+                     t_plan *plans, int k, t_plan_filter filter, void *ctx)
+{
+    t_plan_search search;
+    search.planner = p_planner;
+    search.heap = plans;
+    search.k = k;
+    search.cancel = NULL;
+    search.filter = filter;
+    search.filter_ctx = ctx;
+    return runPlanSearch(&search, loc, draw, nbDraw, nbChoose);
+}
+
+int planBest(const t_planner *p_planner, t_localisation loc, const t_move *draw, int nbDraw, int nbChoose, t_plan *p_plan)
+{
+    return planTopK(p_planner, loc, draw, nbDraw, nbChoose, p_plan, 1);
+}
@@ -0,0 +1,125 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_PLANNER_H
+#define UNTITLED1_PLANNER_H
+
+#include <stdatomic.h>
+#include "loc.h"
+#include "map.h"
+#include "moves.h"
+
+/**
+ * @brief Maximum number of moves drawn (and thus chosen) in a phase
+ */
+#define PLAN_MAX_MOVES 9
+
+/**
+ * @brief Structure for a move sequence chosen from a draw
+ */
+typedef struct s_plan
+{
+    t_move          moves[PLAN_MAX_MOVES];
+    int             nbMoves;
+    int             cost;   // map.costs at the final localisation
+    t_localisation  end;    // final localisation of the robot
+} t_plan;
+
+/**
+ * @brief Type for a filter of the cells visited by the planner (see planTopKFiltered)
+ * @param pos : the position of the robot after a move
+ * @param step : the number of moves done since the start of the phase (1 for the first move)
+ * @param final : 1 if the robot would stop there for the rest of the phase, 0 if it only passes
+ * @param ctx : the context of the filter
+ * @return 1 if the robot may be there, 0 otherwise
+ */
+typedef int (*t_plan_filter)(t_position, int, int, void *);
+
+/**
+ * @brief Structure for the move-selection planner of a map
+ * reach_min[r][y * x_max + x] is the minimal cost within a Manhattan radius r of (x, y),
+ * used as a lower bound on the cost reachable with r cells of translation left
+ */
+typedef struct s_planner
+{
+    t_map   map;
+    int     max_reach;
+    int     **reach_min;
+} t_planner;
+
+/**
+ * @brief Function to create a planner for a map whose costs are already computed
+ * @param map : the map
+ * @param max_reach : the largest translation (in cells) the lower bounds are built for
+ * @return the planner
+ */
+t_planner createPlanner(t_map, int);
+
+/**
+ * @brief Function to free the bound tables of a planner (the map is not freed)
+ * @param p_planner : pointer to the planner
+ * @return none
+ */
+void freePlanner(t_planner *);
+
+/**
+ * @brief Function to find the k best distinct move sequences of a draw
+ * sequences are ordered subsets of the draw of length 1 to nbChoose, simulated with move();
+ * a sequence leaving the map or entering a crevasse is discarded, one reaching the base station stops there.
+ * Plans are ranked by final cost, then by length, then by the moves themselves.
+ * @param p_planner : pointer to the planner
+ * @param loc : the localisation of the robot at the start of the phase
+ * @param draw : the moves drawn for the phase
+ * @param nbDraw : the number of moves drawn (at most PLAN_MAX_MOVES)
+ * @param nbChoose : the maximal number of moves to choose
+ * @param plans : array receiving the plans, best first
+ * @param k : the capacity of the plans array
+ * @return the number of plans written in the array
+ */
+int planTopK(const t_planner *, t_localisation, const t_move *, int, int, t_plan *, int);
+
+/**
+ * @brief Function to find the k best distinct move sequences of a draw, giving up when asked to (see planTopK)
+ * @param p_planner : pointer to the planner
+ * @param loc : the localisation of the robot at the start of the phase
+ * @param draw : the moves drawn for the phase
+ * @param nbDraw : the number of moves drawn
+ * @param nbChoose : the maximal number of moves to choose
+ * @param plans : array receiving the plans, best first
+ * @param k : the capacity of the plans array
+ * @param p_cancel : pointer to a flag polled during the search, the search stops when it is set
+ * @return the number of plans written in the array, -1 if the search was cancelled
+ */
+int planTopKCancellable(const t_planner *, t_localisation, const t_move *, int, int, t_plan *, int, const atomic_int *);
+
+/**
+ * @brief Function to find the k best distinct move sequences of a draw whose cells are accepted by a filter
+ * a move to a cell refused as a passage is not explored further, a plan ending on a cell refused as a stop is
+ * not kept (see planTopK)
+ * @param p_planner : pointer to the planner
+ * @param loc : the localisation of the robot at the start of the phase
+ * @param draw : the moves drawn for the phase
+ * @param nbDraw : the number of moves drawn
+ * @param nbChoose : the maximal number of moves to choose
+ * @param plans : array receiving the plans, best first
+ * @param k : the capacity of the plans array
+ * @param filter : the filter
+ * @param ctx : the context of the filter
+ * @return the number of plans written in the array
+ */
+int planTopKFiltered(const t_planner *, t_localisation, const t_move *, int, int, t_plan *, int, t_plan_filter, void *);
+
+/**
+ * @brief Function to find the best move sequence of a draw (see planTopK)
+ * @param p_planner : pointer to the planner
+ * @param loc : the localisation of the robot
+ * @param draw : the moves drawn for the phase
+ * @param nbDraw : the number of moves drawn
+ * @param nbChoose : the maximal number of moves to choose
+ * @param p_plan : pointer to the plan receiving the result
+ * @return 1 if a plan was found, 0 if every sequence is fatal
+ */
+int planBest(const t_planner *, t_localisation, const t_move *, int, int, t_plan *);
+
+#endif //UNTITLED1_PLANNER_H
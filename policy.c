@@ -0,0 +1,237 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "policy.h"
+
+/**
+ * @brief Magic number at the start of a policy file
+ */
+#define POLICY_MAGIC "MARCPOL1"
+
+/**
+ * @brief Structure for the context of the computation of a policy table
+ */
+typedef struct s_policy_build
+{
+    const t_planner *planner;
+    t_policy        *policy;
+    t_move          draws[POLICY_NB_DRAWS][POLICY_MAX_DRAW];    // the multiset of each index, sorted
+    int             sizes[POLICY_NB_DRAWS];
+} t_policy_build;
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to compute the entries of the states of a range of rows (body of parallelForRows)
+ * @param map : the map
+ * @param y_begin : the first row
+ * @param y_end : the row after the last one
+ * @param ctx : pointer to the t_policy_build
+ * @return none
+ */
+void buildPolicyRows(t_map, int, int, void *);
+
+/* definition of local functions */
+
+void buildPolicyRows(t_map map, int y_begin, int y_end, void *ctx)
+{
+    t_policy_build *p_build = (t_policy_build *)ctx;
+    t_policy *p_policy = p_build->policy;
+    for (int y = y_begin; y < y_end; y++)
+    {
+        for (int x = 0; x < map.x_max; x++)
+        {
+            for (int ori = 0; ori < 4; ori++)
+            {
+                uint16_t *entries = p_policy->entries + ((size_t)(y * map.x_max + x) * 4 + ori) * POLICY_NB_DRAWS;
+                // a robot is never planned from a crevasse
+                if (map.soils[y][x] == CREVASSE)
+                {
+                    memset(entries, 0, POLICY_NB_DRAWS * sizeof(uint16_t));
+                    continue;
+                }
+                t_localisation loc = loc_init(x, y, (t_orientation)ori);
+                for (int d = 0; d < POLICY_NB_DRAWS; d++)
+                {
+                    t_plan plan;
+                    entries[d] = 0;
+                    if (p_build->sizes[d] > 0
+                        && planBest(p_build->planner, loc, p_build->draws[d], p_build->sizes[d], p_policy->nbChoose, &plan))
+                    {
+                        entries[d] = (uint16_t)plan.nbMoves;
+                        for (int i = 0; i < plan.nbMoves; i++)
+                        {
+                            entries[d] |= (uint16_t)(plan.moves[i] << (2 + 3 * i));
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return;
+}
+
+/* definitions of exported functions */
+
+t_policy createPolicy(const t_planner *p_planner, int nbChoose, t_pool *p_pool)
+{
+    assert(nbChoose > 0);
+    t_map map = p_planner->map;
+    t_policy policy;
+    policy.x_max = map.x_max;
+    policy.y_max = map.y_max;
+    policy.nbChoose = (nbChoose < POLICY_MAX_DRAW) ? nbChoose : POLICY_MAX_DRAW;
+    policy.entries = (uint16_t *)malloc((size_t)map.x_max * map.y_max * 4 * POLICY_NB_DRAWS * sizeof(uint16_t));
+
+    // the multisets, each one at its own index
+    t_policy_build build;
+    build.planner = p_planner;
+    build.policy = &policy;
+    build.sizes[0] = 0;
+    for (int a = 0; a < NB_MOVE_TYPES; a++)
+    {
+        t_move draw[POLICY_MAX_DRAW] = {(t_move)a};
+        int d = getPolicyDrawIndex(draw, 1);
+        memcpy(build.draws[d], draw, sizeof(draw));
+        build.sizes[d] = 1;
+        for (int b = a; b < NB_MOVE_TYPES; b++)
+        {
+            draw[1] = (t_move)b;
+            d = getPolicyDrawIndex(draw, 2);
+            memcpy(build.draws[d], draw, sizeof(draw));
+            build.sizes[d] = 2;
+            for (int c = b; c < NB_MOVE_TYPES; c++)
+            {
+                draw[2] = (t_move)c;
+                d = getPolicyDrawIndex(draw, 3);
+                memcpy(build.draws[d], draw, sizeof(draw));
+                build.sizes[d] = 3;
+            }
+        }
+    }
+    parallelForRows(p_pool, map, 0, buildPolicyRows, &build);
+    return policy;
+}
+
+void freePolicy(t_policy *p_policy)
+{
+    free(p_policy->entries);
+    p_policy->entries = NULL;
+    return;
+}
+
+int getPolicyDrawIndex(const t_move *draw, int nbDraw)
+{
+    // index of the first multiset of 0, 1, 2 and 3 moves
+    static const int offsets[POLICY_MAX_DRAW + 1] = {0, 1, 8, 36};
+    assert(nbDraw >= 0 && nbDraw <= POLICY_MAX_DRAW);
+    int m[POLICY_MAX_DRAW];
+    for (int i = 0; i < nbDraw; i++)
+    {
+        int j = i;
+        while (j > 0 && m[j - 1] > (int)draw[i])
+        {
+            m[j] = m[j - 1];
+            j--;
+        }
+        m[j] = (int)draw[i];
+    }
+    // rank in the lexicographic order of the sorted multisets of the same size
+    int rank = 0, low = 0;
+    for (int i = 0; i < nbDraw; i++)
+    {
+        int left = nbDraw - i - 1;
+        for (int v = low; v < m[i]; v++)
+        {
+            // multisets of the remaining size with values from v to 6 : C(7 - v + left - 1, left)
+            int n = NB_MOVE_TYPES - v, count = 1;
+            for (int k = 1; k <= left; k++)
+            {
+                count = count * (n + k - 1) / k;
+            }
+            rank += count;
+        }
+        low = m[i];
+    }
+    return offsets[nbDraw] + rank;
+}
+
+int getPolicyMoves(const t_policy *p_policy, t_localisation loc, const t_move *draw, int nbDraw, t_move *chosen)
+{
+    assert(isValidLocalisation(loc.pos, p_policy->x_max, p_policy->y_max));
+    size_t state = (size_t)(loc.pos.y * p_policy->x_max + loc.pos.x) * 4 + loc.ori;
+    uint16_t entry = p_policy->entries[state * POLICY_NB_DRAWS + getPolicyDrawIndex(draw, nbDraw)];
+    int nbMoves = entry & 3;
+    for (int i = 0; i < nbMoves; i++)
+    {
+        chosen[i] = (t_move)((entry >> (2 + 3 * i)) & 7);
+    }
+    return nbMoves;
+}
+
+int policyStrategy(t_map map, t_localisation loc, const t_move *draw, int nbDraw, int nbChoose, t_move *chosen, void *ctx)
+{
+    const t_policy *p_policy = (const t_policy *)ctx;
+    (void)map;
+    (void)nbChoose;
+    // the table was computed for this map
+    assert(map.x_max == p_policy->x_max && map.y_max == p_policy->y_max);
+    assert(nbDraw <= POLICY_MAX_DRAW && (nbChoose == p_policy->nbChoose || (nbChoose >= nbDraw && p_policy->nbChoose >= nbDraw)));
+    return getPolicyMoves(p_policy, loc, draw, nbDraw, chosen);
+}
+
+void savePolicy(const t_policy *p_policy, char *filename)
+{
+    FILE *file = fopen(filename, "wb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Error: cannot open file %s\n", filename);
+        exit(1);
+    }
+    int header[3] = {p_policy->x_max, p_policy->y_max, p_policy->nbChoose};
+    size_t nbEntries = (size_t)p_policy->x_max * p_policy->y_max * 4 * POLICY_NB_DRAWS;
+    if (fwrite(POLICY_MAGIC, 8, 1, file) != 1 || fwrite(header, sizeof(header), 1, file) != 1
+        || fwrite(p_policy->entries, sizeof(uint16_t), nbEntries, file) != nbEntries || fclose(file) != 0)
+    {
+        fprintf(stderr, "Error: cannot write file %s\n", filename);
+        exit(1);
+    }
+    return;
+}
+
+int loadPolicy(char *filename, t_policy *p_policy)
+{
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL)
+    {
+        return 0;
+    }
+    char magic[8];
+    int header[3];
+    if (fread(magic, 8, 1, file) != 1 || memcmp(magic, POLICY_MAGIC, 8) != 0 || fread(header, sizeof(header), 1, file) != 1
+        || header[0] <= 0 || header[1] <= 0 || header[2] <= 0 || header[2] > POLICY_MAX_DRAW)
+    {
+        fclose(file);
+        return 0;
+    }
+    size_t nbEntries = (size_t)header[0] * header[1] * 4 * POLICY_NB_DRAWS;
+    uint16_t *entries = (uint16_t *)malloc(nbEntries * sizeof(uint16_t));
+    int ok = (fread(entries, sizeof(uint16_t), nbEntries, file) == nbEntries);
+    fclose(file);
+    if (!ok)
+    {
+        free(entries);
+        return 0;
+    }
+    p_policy->x_max = header[0];
+    p_policy->y_max = header[1];
+    p_policy->nbChoose = header[2];
+    p_policy->entries = entries;
+    return 1;
+}
@@ -0,0 +1,102 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_POLICY_H
+#define UNTITLED1_POLICY_H
+
+#include <stdint.h>
+#include "loc.h"
+#include "map.h"
+#include "moves.h"
+#include "planner.h"
+#include "pool.h"
+
+/**
+ * @brief Largest draw a policy table has entries for
+ */
+#define POLICY_MAX_DRAW 3
+
+/**
+ * @brief Number of multisets of at most POLICY_MAX_DRAW moves among the 7 kinds : 1 + 7 + 28 + 84
+ */
+#define POLICY_NB_DRAWS 120
+
+/**
+ * @brief Structure for the table of the best move orders of the small draws of a map
+ * the entry of a state (x, y, orientation) and a draw multiset is the plan of planBest packed on 16 bits :
+ * the number of moves on bits 0-1, then the moves on 3 bits each; 0 when every sequence is fatal
+ */
+typedef struct s_policy
+{
+    int         x_max;
+    int         y_max;
+    int         nbChoose;
+    uint16_t    *entries;   // POLICY_NB_DRAWS per state, state ((y * x_max + x) * 4 + orientation)
+} t_policy;
+
+/**
+ * @brief Function to compute the policy table of a planner, in parallel over the rows of the map
+ * @param p_planner : pointer to the planner
+ * @param nbChoose : the maximal number of moves to choose (applied to every draw size)
+ * @param p_pool : pointer to the pool of workers
+ * @return the policy table
+ */
+t_policy createPolicy(const t_planner *, int, t_pool *);
+
+/**
+ * @brief Function to free a policy table
+ * @param p_policy : pointer to the policy table
+ * @return none
+ */
+void freePolicy(t_policy *);
+
+/**
+ * @brief Function to get the index of a draw multiset in the entries of a state
+ * @param draw : the moves drawn, in any order
+ * @param nbDraw : the number of moves drawn (at most POLICY_MAX_DRAW)
+ * @return the index, from 0 to POLICY_NB_DRAWS - 1
+ */
+int getPolicyDrawIndex(const t_move *, int);
+
+/**
+ * @brief Function to read the best move order of a draw in a policy table
+ * @param p_policy : pointer to the policy table
+ * @param loc : the localisation of the robot, on the map
+ * @param draw : the moves drawn
+ * @param nbDraw : the number of moves drawn (at most POLICY_MAX_DRAW)
+ * @param chosen : array receiving the moves, in order
+ * @return the number of moves chosen, 0 if every sequence is fatal
+ */
+int getPolicyMoves(const t_policy *, t_localisation, const t_move *, int, t_move *);
+
+/**
+ * @brief Function to get the strategy of a policy table (see t_strategy), for draws of at most POLICY_MAX_DRAW moves
+ * @param map : the map the table was built for (its dimensions are checked in debug builds)
+ * @param loc : the localisation of the robot
+ * @param draw : the moves drawn
+ * @param nbDraw : the number of moves drawn
+ * @param nbChoose : the maximal number of moves to choose, the one the table was built with
+ * @param chosen : array receiving the moves
+ * @param ctx : pointer to the t_policy
+ * @return the number of moves chosen
+ */
+int policyStrategy(t_map, t_localisation, const t_move *, int, int, t_move *, void *);
+
+/**
+ * @brief Function to save a policy table in a binary file
+ * @param p_policy : pointer to the policy table
+ * @param filename : the name of the file
+ * @return none
+ */
+void savePolicy(const t_policy *, char *);
+
+/**
+ * @brief Function to load a policy table from a binary file
+ * @param filename : the name of the file
+ * @param p_policy : pointer to the policy table receiving the file
+ * @return 1 if the file is a complete policy table, 0 otherwise
+ */
+int loadPolicy(char *, t_policy *);
+
+#endif //UNTITLED1_POLICY_H
@@ -0,0 +1,403 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#define _GNU_SOURCE
+#include <assert.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "pool.h"
+
+/**
+ * @brief Initial number of tasks of a worker queue
+ */
+#define POOL_QUEUE_SIZE 64
+
+/**
+ * @brief Structure for the argument of a worker thread
+ */
+typedef struct s_worker_arg
+{
+    t_pool  *pool;
+    int     index;
+} t_worker_arg;
+
+/**
+ * @brief Structure for a range of rows of a parallelForRows call
+ */
+typedef struct s_rows_task
+{
+    t_rows_fn   fn;
+    t_map       map;
+    int         y_begin;
+    int         y_end;
+    void        *ctx;
+} t_rows_task;
+
+/**
+ * @brief Pool and index of the worker running on the current thread (NULL outside of a pool)
+ */
+static _Thread_local t_pool *tl_pool = NULL;
+static _Thread_local int tl_worker = -1;
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to push a task at the end of a queue, growing it when full
+ * @param p_queue : pointer to the queue
+ * @param task : the task
+ * @return none
+ */
+void pushTask(t_task_queue *, t_task);
+
+/**
+ * @brief function to move the tasks of a queue to a larger array, the lock of the queue must be held
+ * @param p_queue : pointer to the queue
+ * @param size : the new size, at least the number of tasks of the queue
+ * @return none
+ */
+void growTaskQueue(t_task_queue *, int);
+
+/**
+ * @brief function to take a task, from the given queue first (newest task) then from the others (oldest task)
+ * @param p_pool : pointer to the pool
+ * @param index : the index of the preferred queue
+ * @param p_task : pointer to the task taken
+ * @return 1 if a task was taken, 0 if all the queues are empty
+ */
+int takeTask(t_pool *, int, t_task *);
+
+/**
+ * @brief function to run a task and signal its group when it was the last one
+ * @param p_task : pointer to the task
+ * @return none
+ */
+void runTask(t_task *);
+
+/**
+ * @brief function run by the workers
+ * @param arg : pointer to the t_worker_arg of the worker (freed by the worker)
+ * @return NULL
+ */
+void *workerThread(void *);
+
+/**
+ * @brief task running the body of a parallelForRows call on a range of rows
+ * @param arg : pointer to the t_rows_task
+ * @return none
+ */
+void runRowsTask(void *);
+
+/* definition of local functions */
+
+void pushTask(t_task_queue *p_queue, t_task task)
+{
+    pthread_mutex_lock(&p_queue->lock);
+    if (p_queue->last - p_queue->first == p_queue->size)
+    {
+        growTaskQueue(p_queue, 2 * p_queue->size);
+    }
+    p_queue->tasks[p_queue->last % p_queue->size] = task;
+    p_queue->last++;
+    pthread_mutex_unlock(&p_queue->lock);
+    return;
+}
+
+void growTaskQueue(t_task_queue *p_queue, int size)
+{
+    t_task *tasks = (t_task *)malloc(size * sizeof(t_task));
+    for (int i = p_queue->first; i < p_queue->last; i++)
+    {
+        tasks[i - p_queue->first] = p_queue->tasks[i % p_queue->size];
+    }
+    free(p_queue->tasks);
+    p_queue->tasks = tasks;
+    p_queue->last -= p_queue->first;
+    p_queue->first = 0;
+    p_queue->size = size;
+    return;
+}
+
+int takeTask(t_pool *p_pool, int index, t_task *p_task)
+{
+    if (atomic_load(&p_pool->nbQueued) == 0)
+    {
+        return 0;
+    }
+    for (int k = 0; k < p_pool->nbWorkers; k++)
+    {
+        t_task_queue *p_queue = &p_pool->queues[(index + k) % p_pool->nbWorkers];
+        pthread_mutex_lock(&p_queue->lock);
+        if (p_queue->first != p_queue->last)
+        {
+            if (k == 0)
+            {
+                // own queue : the newest task, whose data is likely still in cache
+                p_queue->last--;
+                *p_task = p_queue->tasks[p_queue->last % p_queue->size];
+            }
+            else
+            {
+                // stolen : the oldest task, usually the largest remaining piece of work
+                *p_task = p_queue->tasks[p_queue->first % p_queue->size];
+                p_queue->first++;
+            }
+            // the indices stay in [0, 2 * size) : they would overflow in a long-lived pool otherwise
+            if (p_queue->first == p_queue->last)
+            {
+                p_queue->first = 0;
+                p_queue->last = 0;
+            }
+            else if (p_queue->first >= p_queue->size)
+            {
+                p_queue->first -= p_queue->size;
+                p_queue->last -= p_queue->size;
+            }
+            pthread_mutex_unlock(&p_queue->lock);
+            atomic_fetch_sub(&p_pool->nbQueued, 1);
+            return 1;
+        }
+        pthread_mutex_unlock(&p_queue->lock);
+    }
+    return 0;
+}
+
+void runTask(t_task *p_task)
+{
+    p_task->fn(p_task->arg);
+    t_task_group *p_group = p_task->group;
+    if (p_group != NULL)
+    {
+        // the count drops under the lock, so a waiter cannot destroy the group while it is signalled
+        pthread_mutex_lock(&p_group->lock);
+        if (atomic_fetch_sub(&p_group->pending, 1) == 1)
+        {
+            pthread_cond_broadcast(&p_group->done);
+        }
+        pthread_mutex_unlock(&p_group->lock);
+    }
+    return;
+}
+
+void *workerThread(void *arg)
+{
+    t_worker_arg *p_arg = (t_worker_arg *)arg;
+    t_pool *p_pool = p_arg->pool;
+    int index = p_arg->index;
+    free(p_arg);
+    tl_pool = p_pool;
+    tl_worker = index;
+    while (1)
+    {
+        t_task task;
+        if (takeTask(p_pool, index, &task))
+        {
+            runTask(&task);
+            continue;
+        }
+        pthread_mutex_lock(&p_pool->idle_lock);
+        while (atomic_load(&p_pool->nbQueued) == 0 && !p_pool->stop)
+        {
+            pthread_cond_wait(&p_pool->idle, &p_pool->idle_lock);
+        }
+        int over = p_pool->stop && atomic_load(&p_pool->nbQueued) == 0;
+        pthread_mutex_unlock(&p_pool->idle_lock);
+        if (over)
+        {
+            break;
+        }
+    }
+    return NULL;
+}
+
+void runRowsTask(void *arg)
+{
+    t_rows_task *p_rows = (t_rows_task *)arg;
+    p_rows->fn(p_rows->map, p_rows->y_begin, p_rows->y_end, p_rows->ctx);
+    return;
+}
+
+/* definitions of exported functions */
+
+t_pool *createPool(int nbWorkers, int pin)
+{
+    int nbCpus = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (nbCpus < 1)
+    {
+        nbCpus = 1;
+    }
+    if (nbWorkers <= 0)
+    {
+        nbWorkers = nbCpus;
+    }
+    t_pool *p_pool = (t_pool *)malloc(sizeof(t_pool));
+    p_pool->nbWorkers = nbWorkers;
+    atomic_init(&p_pool->nbQueued, 0);
+    atomic_init(&p_pool->next, 0);
+    p_pool->stop = 0;
+    pthread_mutex_init(&p_pool->idle_lock, NULL);
+    pthread_cond_init(&p_pool->idle, NULL);
+    p_pool->queues = (t_task_queue *)malloc(nbWorkers * sizeof(t_task_queue));
+    for (int i = 0; i < nbWorkers; i++)
+    {
+        p_pool->queues[i].tasks = (t_task *)malloc(POOL_QUEUE_SIZE * sizeof(t_task));
+        p_pool->queues[i].size = POOL_QUEUE_SIZE;
+        p_pool->queues[i].first = 0;
+        p_pool->queues[i].last = 0;
+        pthread_mutex_init(&p_pool->queues[i].lock, NULL);
+    }
+    p_pool->threads = (pthread_t *)malloc(nbWorkers * sizeof(pthread_t));
+    for (int i = 0; i < nbWorkers; i++)
+    {
+        t_worker_arg *p_arg = (t_worker_arg *)malloc(sizeof(t_worker_arg));
+        p_arg->pool = p_pool;
+        p_arg->index = i;
+        if (pthread_create(&p_pool->threads[i], NULL, workerThread, p_arg) != 0)
+        {
+            fprintf(stderr, "Error: cannot create worker thread %d\n", i);
+            exit(1);
+        }
+        if (pin)
+        {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(i % nbCpus, &cpus);
+            // pinning is an optimisation : a refused affinity is not an error
+            if (pthread_setaffinity_np(p_pool->threads[i], sizeof(cpu_set_t), &cpus) != 0)
+            {
+                fprintf(stderr, "Warning: cannot pin worker %d to CPU %d\n", i, i % nbCpus);
+            }
+        }
+    }
+    return p_pool;
+}
+
+void freePool(t_pool *p_pool)
+{
+    pthread_mutex_lock(&p_pool->idle_lock);
+    p_pool->stop = 1;
+    pthread_cond_broadcast(&p_pool->idle);
+    pthread_mutex_unlock(&p_pool->idle_lock);
+    for (int i = 0; i < p_pool->nbWorkers; i++)
+    {
+        pthread_join(p_pool->threads[i], NULL);
+    }
+    for (int i = 0; i < p_pool->nbWorkers; i++)
+    {
+        pthread_mutex_destroy(&p_pool->queues[i].lock);
+        free(p_pool->queues[i].tasks);
+    }
+    pthread_cond_destroy(&p_pool->idle);
+    pthread_mutex_destroy(&p_pool->idle_lock);
+    free(p_pool->queues);
+    free(p_pool->threads);
+    free(p_pool);
+    return;
+}
+
+void reservePoolQueues(t_pool *p_pool, int nbTasks)
+{
+    for (int i = 0; i < p_pool->nbWorkers; i++)
+    {
+        t_task_queue *p_queue = &p_pool->queues[i];
+        pthread_mutex_lock(&p_queue->lock);
+        if (p_queue->size < nbTasks)
+        {
+            growTaskQueue(p_queue, nbTasks);
+        }
+        pthread_mutex_unlock(&p_queue->lock);
+    }
+    return;
+}
+
+void initTaskGroup(t_task_group *p_group)
+{
+    atomic_init(&p_group->pending, 0);
+    pthread_mutex_init(&p_group->lock, NULL);
+    pthread_cond_init(&p_group->done, NULL);
+    return;
+}
+
+void destroyTaskGroup(t_task_group *p_group)
+{
+    assert(atomic_load(&p_group->pending) == 0);
+    pthread_cond_destroy(&p_group->done);
+    pthread_mutex_destroy(&p_group->lock);
+    return;
+}
+
+void submitTask(t_pool *p_pool, t_task_group *p_group, t_task_fn fn, void *arg)
+{
+    t_task task;
+    task.fn = fn;
+    task.arg = arg;
+    task.group = p_group;
+    if (p_group != NULL)
+    {
+        atomic_fetch_add(&p_group->pending, 1);
+    }
+    int index = (tl_pool == p_pool) ? tl_worker : (int)(atomic_fetch_add(&p_pool->next, 1) % p_pool->nbWorkers);
+    pushTask(&p_pool->queues[index], task);
+    atomic_fetch_add(&p_pool->nbQueued, 1);
+    pthread_mutex_lock(&p_pool->idle_lock);
+    pthread_cond_signal(&p_pool->idle);
+    pthread_mutex_unlock(&p_pool->idle_lock);
+    return;
+}
+
+void waitTaskGroup(t_pool *p_pool, t_task_group *p_group)
+{
+    int index = (tl_pool == p_pool) ? tl_worker : 0;
+    while (atomic_load(&p_group->pending) > 0)
+    {
+        // the waiting thread helps instead of blocking, so nested waits cannot starve the pool
+        t_task task;
+        if (takeTask(p_pool, index, &task))
+        {
+            runTask(&task);
+            continue;
+        }
+        pthread_mutex_lock(&p_group->lock);
+        while (atomic_load(&p_group->pending) > 0 && atomic_load(&p_pool->nbQueued) == 0)
+        {
+            pthread_cond_wait(&p_group->done, &p_group->lock);
+        }
+        pthread_mutex_unlock(&p_group->lock);
+    }
+    // the last task may still hold the lock of the group after its count dropped
+    pthread_mutex_lock(&p_group->lock);
+    pthread_mutex_unlock(&p_group->lock);
+    return;
+}
+
+void parallelForRows(t_pool *p_pool, t_map map, int grain, t_rows_fn fn, void *ctx)
+{
+    if (map.y_max <= 0)
+    {
+        return;
+    }
+    if (grain <= 0)
+    {
+        grain = (map.y_max + p_pool->nbWorkers - 1) / p_pool->nbWorkers;
+    }
+    int nbTasks = (map.y_max + grain - 1) / grain;
+    t_rows_task *tasks = (t_rows_task *)malloc(nbTasks * sizeof(t_rows_task));
+    t_task_group group;
+    initTaskGroup(&group);
+    for (int t = 0; t < nbTasks; t++)
+    {
+        tasks[t].fn = fn;
+        tasks[t].map = map;
+        tasks[t].y_begin = t * grain;
+        tasks[t].y_end = (t * grain + grain < map.y_max) ? t * grain + grain : map.y_max;
+        tasks[t].ctx = ctx;
+        submitTask(p_pool, &group, runRowsTask, &tasks[t]);
+    }
+    waitTaskGroup(p_pool, &group);
+    destroyTaskGroup(&group);
+    free(tasks);
+    return;
+}
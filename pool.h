@@ -0,0 +1,145 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_POOL_H
+#define UNTITLED1_POOL_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include "map.h"
+
+/**
+ * @brief Type for the function of a task
+ * @param arg : the argument given when the task was submitted
+ */
+typedef void (*t_task_fn)(void *);
+
+/**
+ * @brief Type for the body of a parallel loop over the rows of a map
+ * @param map : the map
+ * @param y_begin : the first row of the range
+ * @param y_end : the row after the last row of the range
+ * @param ctx : the context given to parallelForRows
+ */
+typedef void (*t_rows_fn)(t_map, int, int, void *);
+
+/**
+ * @brief Structure for a group of tasks that can be waited for together
+ */
+typedef struct s_task_group
+{
+    atomic_int      pending;
+    pthread_mutex_t lock;
+    pthread_cond_t  done;
+} t_task_group;
+
+/**
+ * @brief Structure for a task : a function, its argument and its group
+ */
+typedef struct s_task
+{
+    t_task_fn       fn;
+    void            *arg;
+    t_task_group    *group;
+} t_task;
+
+/**
+ * @brief Structure for the queue of tasks of a worker (circular, grown when full)
+ * first is kept in [0, size) and last in [first, first + size], so the indices never overflow
+ */
+typedef struct s_task_queue
+{
+    t_task          *tasks;
+    int             size;
+    int             first;
+    int             last;
+    pthread_mutex_t lock;
+} t_task_queue;
+
+/**
+ * @brief Structure for the thread pool
+ * each worker runs the tasks of its own queue first and steals from the other queues when it is empty
+ */
+typedef struct s_pool
+{
+    pthread_t       *threads;
+    t_task_queue    *queues;
+    int             nbWorkers;
+    atomic_int      nbQueued;   // tasks in the queues, not yet started
+    atomic_uint     next;       // queue of the next task submitted from outside the pool
+    pthread_mutex_t idle_lock;
+    pthread_cond_t  idle;       // signalled when tasks are queued or on stop
+    int             stop;
+} t_pool;
+
+/**
+ * @brief Function to create a thread pool
+ * @param nbWorkers : the number of workers, 0 for one per online CPU
+ * @param pin : 1 to pin worker i to CPU i (modulo the number of CPUs)
+ * @return pointer to the pool
+ */
+t_pool *createPool(int, int);
+
+/**
+ * @brief Function to stop the workers of a pool and free it, the queued tasks are run first
+ * @param p_pool : pointer to the pool
+ * @return none
+ */
+void freePool(t_pool *);
+
+/**
+ * @brief Function to grow the queue of every worker to a number of tasks at least, so that submitting up to
+ * that many tasks never allocates (e.g. before a real-time phase, see rt.h)
+ * @param p_pool : pointer to the pool
+ * @param nbTasks : the number of tasks
+ * @return none
+ */
+void reservePoolQueues(t_pool *, int);
+
+/**
+ * @brief Function to initialise an empty task group
+ * @param p_group : pointer to the group
+ * @return none
+ */
+void initTaskGroup(t_task_group *);
+
+/**
+ * @brief Function to release the resources of a task group (no task may be pending)
+ * @param p_group : pointer to the group
+ * @return none
+ */
+void destroyTaskGroup(t_task_group *);
+
+/**
+ * @brief Function to submit a task to the pool
+ * a task submitted by a worker goes to its own queue, otherwise the queues are used in turn; it does not allocate
+ * while the queue has room (see reservePoolQueues)
+ * @param p_pool : pointer to the pool
+ * @param p_group : pointer to the group of the task, may be NULL
+ * @param fn : the function of the task
+ * @param arg : the argument of the function
+ * @return none
+ */
+void submitTask(t_pool *, t_task_group *, t_task_fn, void *);
+
+/**
+ * @brief Function to wait for all the tasks of a group, running queued tasks meanwhile
+ * @param p_pool : pointer to the pool
+ * @param p_group : pointer to the group
+ * @return none
+ */
+void waitTaskGroup(t_pool *, t_task_group *);
+
+/**
+ * @brief Function to run a loop body over the rows of a map in parallel and wait for it
+ * @param p_pool : pointer to the pool
+ * @param map : the map
+ * @param grain : the number of rows per task (0 to split the rows evenly between the workers)
+ * @param fn : the body of the loop, called on disjoint row ranges
+ * @param ctx : the context given to the body
+ * @return none
+ */
+void parallelForRows(t_pool *, t_map, int, t_rows_fn, void *);
+
+#endif //UNTITLED1_POOL_H
@@ -0,0 +1,214 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "draw.h"
+#include "mission.h"
+#include "pack.h"
+#include "trace.h"
+
+/**
+ * @brief Number of localisations queried most of the time on each map of a generated trace
+ */
+#define REPLAY_HOT_LOCS 32
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to get the names of the maps of a pack, in slot order
+ * @param p_pack : pointer to the pack
+ * @return the names, pointing into the pack (the array is to be freed)
+ */
+char **getPackNames(const t_pack *);
+
+/**
+ * @brief function to write a trace with the mix of a live workload : a few hot maps (Zipf), a few hot
+ * localisations per map, bursts of queries at the same time, mostly costs, then paths, then plans
+ * @param filename : the name of the trace file
+ * @param p_pack : pointer to the pack of the maps
+ * @param nbQueries : the number of queries
+ * @param rate : the mean number of queries per second
+ * @param seed : the seed of the trace
+ * @return none
+ */
+void generateTrace(char *, const t_pack *, uint64_t, double, uint64_t);
+
+/* definition of local functions */
+
+char **getPackNames(const t_pack *p_pack)
+{
+    char **names = (char **)malloc((p_pack->nbMaps + 1) * sizeof(char *));
+    int nb = 0;
+    for (uint64_t s = 0; s < p_pack->nbSlots; s++)
+    {
+        if (p_pack->slots[s].name != 0)
+        {
+            names[nb++] = p_pack->data + p_pack->slots[s].name;
+        }
+    }
+    return names;
+}
+
+void generateTrace(char *filename, const t_pack *p_pack, uint64_t nbQueries, double rate, uint64_t seed)
+{
+    char **names = getPackNames(p_pack);
+    int nbMaps = p_pack->nbMaps;
+    t_map *maps = (t_map *)malloc(nbMaps * sizeof(t_map));
+    t_localisation *hot = (t_localisation *)malloc(nbMaps * REPLAY_HOT_LOCS * sizeof(t_localisation));
+    double *weights = (double *)malloc(nbMaps * sizeof(double));
+    double total = 0.0;
+    for (int m = 0; m < nbMaps; m++)
+    {
+        getPackMap(p_pack, names[m], &maps[m]);
+        for (int h = 0; h < REPLAY_HOT_LOCS; h++)
+        {
+            hot[m * REPLAY_HOT_LOCS + h] = drawStartLocalisation(maps[m], seed * 1000003 + m * REPLAY_HOT_LOCS + h);
+        }
+        total += 1.0 / (m + 1);
+        weights[m] = total;
+    }
+
+    t_rng rng = createRng(seed, 0);
+    t_trace_writer writer = createTraceWriter(filename);
+    double time_ns = 0.0;
+    int burst = 0, m = 0, kind = 0;
+    // the pack has a map at least (checked by the caller)
+    assert(nbMaps > 0);
+    t_localisation loc = drawStartLocalisation(maps[0], seed);
+    t_move draw[PLAN_MAX_MOVES];
+    for (uint64_t q = 0; q < nbQueries; q++)
+    {
+        // half of the queries of a burst repeat the one before, as robots of a fleet in the same place do
+        int repeat = (burst > 0 && randomBelow(&rng, 2) == 0);
+        if (burst > 0)
+        {
+            burst--;
+        }
+        else
+        {
+            double u = ((nextRandom(&rng) >> 11) + 1) * (1.0 / 9007199254740992.0);
+            time_ns += -log(u) / rate * 1e9;
+            burst = (randomBelow(&rng, 8) == 0) ? randomBelow(&rng, 16) : 0;
+        }
+        if (!repeat)
+        {
+            double w = (nextRandom(&rng) >> 11) * (1.0 / 9007199254740992.0) * total;
+            m = 0;
+            while (m < nbMaps - 1 && weights[m] < w)
+            {
+                m++;
+            }
+            loc = (randomBelow(&rng, 5) != 0) ? hot[m * REPLAY_HOT_LOCS + randomBelow(&rng, REPLAY_HOT_LOCS)]
+                                              : drawStartLocalisation(maps[m], nextRandom(&rng));
+            kind = randomBelow(&rng, 20);
+            drawMoves(&rng, draw, PLAN_MAX_MOVES);
+        }
+        if (kind < 12)
+        {
+            addTraceQuery(&writer, (uint64_t)time_ns, names[m], QUERY_COST, loc);
+        }
+        else if (kind < 17)
+        {
+            addTraceQuery(&writer, (uint64_t)time_ns, names[m], QUERY_PATH, loc);
+        }
+        else
+        {
+            addTracePlanQuery(&writer, (uint64_t)time_ns, names[m], loc, draw, PLAN_MAX_MOVES, 5);
+        }
+    }
+    closeTraceWriter(&writer);
+    for (int m = 0; m < nbMaps; m++)
+    {
+        freePackMap(&maps[m]);
+    }
+    free(maps);
+    free(hot);
+    free(weights);
+    free(names);
+    return;
+}
+
+/**
+ * replay [-c] <trace file> <pack file> [workers] [speed] : replays a trace against the maps of a pack (packed
+ *                                                         with their costs), open-loop, at speed times its rate
+ *                                                         (-c : identical plan queries in flight are coalesced)
+ * replay -g <trace file> <pack file> <queries> <rate> <seed> : writes a trace with a live-like query mix
+ */
+int main(int argc, char **argv)
+{
+    if (argc == 7 && strcmp(argv[1], "-g") == 0)
+    {
+        t_pack pack = openPack(argv[3]);
+        uint64_t nbQueries = strtoull(argv[4], NULL, 10);
+        double rate = atof(argv[5]);
+        if (pack.nbMaps == 0 || rate <= 0.0)
+        {
+            fprintf(stderr, "Error: empty pack or invalid rate\n");
+            return 1;
+        }
+        generateTrace(argv[2], &pack, nbQueries, rate, strtoull(argv[6], NULL, 10));
+        closePack(&pack);
+        printf("%llu queries written in %s\n", (unsigned long long)nbQueries, argv[2]);
+        return 0;
+    }
+    int coalesce = (argc > 1 && strcmp(argv[1], "-c") == 0);
+    char **args = argv + coalesce;
+    int nbArgs = argc - coalesce;
+    if (nbArgs < 3 || nbArgs > 5)
+    {
+        fprintf(stderr, "Usage: %s [-c] <trace file> <pack file> [workers] [speed]\n"
+                        "       %s -g <trace file> <pack file> <queries> <rate> <seed>\n", argv[0], argv[0]);
+        return 1;
+    }
+    int nbWorkers = (nbArgs > 3) ? atoi(args[3]) : 0;
+    double speed = (nbArgs > 4) ? atof(args[4]) : 1.0;
+    if (nbWorkers < 0 || speed < 0.0)
+    {
+        fprintf(stderr, "Error: invalid number of workers or speed\n");
+        return 1;
+    }
+
+    t_trace trace = loadTrace(args[1]);
+    t_pack pack = openPack(args[2]);
+    t_replay_target *targets = (t_replay_target *)malloc(trace.nbMaps * sizeof(t_replay_target));
+    t_coalescer *p_coalescer = coalesce ? createCoalescer(0) : NULL;
+    for (int m = 0; m < trace.nbMaps; m++)
+    {
+        t_map map;
+        if (!getPackMap(&pack, trace.names[m], &map) || map.costs == NULL)
+        {
+            fprintf(stderr, "Error: map %s not found in %s with its costs\n", trace.names[m], args[2]);
+            return 1;
+        }
+        targets[m] = createReplayTarget(map, 15);
+        targets[m].coalescer = p_coalescer;
+    }
+    t_pool *p_pool = createPool(nbWorkers, 0);
+    t_replay_report report = replayTrace(&trace, targets, p_pool, speed);
+    printf("%d workers, speed %g\n", p_pool->nbWorkers, speed);
+    printReplayReport(&report, stdout);
+    if (p_coalescer != NULL)
+    {
+        t_coalesce_stats stats = getCoalesceStats(p_coalescer);
+        printf("coalescing : %llu plan queries, %llu computed, %llu coalesced, %.3f ms saved, %.3f ms waited\n",
+               (unsigned long long)stats.nbRequests, (unsigned long long)stats.nbComputed,
+               (unsigned long long)stats.nbCoalesced, stats.saved_ns / 1e6, stats.waited_ns / 1e6);
+        freeCoalescer(p_coalescer);
+    }
+    freePool(p_pool);
+    for (int m = 0; m < trace.nbMaps; m++)
+    {
+        freeReplayTarget(&targets[m]);
+        freePackMap(&targets[m].map);
+    }
+    free(targets);
+    closePack(&pack);
+    freeTrace(&trace);
+    return 0;
+}
@@ -0,0 +1,119 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "reservation.h"
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to get the key of a cell at a time step
+ * @param pos : the position of the cell
+ * @param step : the time step
+ * @return the key
+ */
+uint64_t getReservationKey(t_position, int);
+
+/**
+ * @brief function to get the first slot probed for a key (Fibonacci hashing)
+ * @param p_table : pointer to the table
+ * @param key : the key
+ * @return the index of the slot
+ */
+int getReservationSlot(const t_reservation_table *, uint64_t);
+
+/* definition of local functions */
+
+uint64_t getReservationKey(t_position pos, int step)
+{
+    assert(pos.x >= 0 && pos.y >= 0 && step >= 0);
+    return ((uint64_t)(uint32_t)step << 48) | ((uint64_t)(uint32_t)pos.y << 24) | (uint64_t)(uint32_t)pos.x;
+}
+
+int getReservationSlot(const t_reservation_table *p_table, uint64_t key)
+{
+    return (int)((key * 0x9E3779B97F4A7C15ull) >> 32) & (p_table->nbSlots - 1);
+}
+
+/* definitions of exported functions */
+
+t_reservation_table createReservationTable(int maxReserved)
+{
+    assert(maxReserved > 0);
+    t_reservation_table table;
+    table.nbSlots = 16;
+    while (table.nbSlots < 2 * maxReserved)
+    {
+        table.nbSlots *= 2;
+    }
+    table.maxReserved = table.nbSlots / 2;
+    table.nbReserved = 0;
+    // stamps of 0 are never the generation of the table : every slot starts empty
+    table.slots = (t_reservation_slot *)calloc(table.nbSlots, sizeof(t_reservation_slot));
+    table.generation = 1;
+    return table;
+}
+
+void freeReservationTable(t_reservation_table *p_table)
+{
+    free(p_table->slots);
+    p_table->slots = NULL;
+    return;
+}
+
+void clearReservations(t_reservation_table *p_table)
+{
+    p_table->nbReserved = 0;
+    p_table->generation++;
+    if (p_table->generation == 0)
+    {
+        // after 2^32 phases, the stamps of old phases could be taken for the new one
+        memset(p_table->slots, 0, p_table->nbSlots * sizeof(t_reservation_slot));
+        p_table->generation = 1;
+    }
+    return;
+}
+
+int reserveCell(t_reservation_table *p_table, t_position pos, int step, int robot)
+{
+    uint64_t key = getReservationKey(pos, step);
+    int s = getReservationSlot(p_table, key);
+    while (p_table->slots[s].stamp == p_table->generation)
+    {
+        if (p_table->slots[s].key == key)
+        {
+            return p_table->slots[s].robot == robot;
+        }
+        s = (s + 1) & (p_table->nbSlots - 1);
+    }
+    if (p_table->nbReserved == p_table->maxReserved)
+    {
+        fprintf(stderr, "Error: more than %d reservations in the table\n", p_table->maxReserved);
+        exit(1);
+    }
+    p_table->slots[s].key = key;
+    p_table->slots[s].stamp = p_table->generation;
+    p_table->slots[s].robot = robot;
+    p_table->nbReserved++;
+    return 1;
+}
+
+int getCellReservation(const t_reservation_table *p_table, t_position pos, int step)
+{
+    uint64_t key = getReservationKey(pos, step);
+    int s = getReservationSlot(p_table, key);
+    while (p_table->slots[s].stamp == p_table->generation)
+    {
+        if (p_table->slots[s].key == key)
+        {
+            return p_table->slots[s].robot;
+        }
+        s = (s + 1) & (p_table->nbSlots - 1);
+    }
+    return -1;
+}
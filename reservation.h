@@ -0,0 +1,75 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_RESERVATION_H
+#define UNTITLED1_RESERVATION_H
+
+#include <stdint.h>
+#include "loc.h"
+
+/**
+ * @brief Structure for a slot of a reservation table
+ */
+typedef struct s_reservation_slot
+{
+    uint64_t    key;    // cell and time step
+    uint32_t    stamp;  // generation of the slot, the slot is empty if it is not the one of the table
+    int32_t     robot;
+} t_reservation_slot;
+
+/**
+ * @brief Structure for a table of the (cell, time step) slots reserved by robots
+ * open addressing in a fixed power of 2 of slots; clearing the table only changes its generation,
+ * so it is recycled from a phase to the next without being reallocated nor cleaned
+ */
+typedef struct s_reservation_table
+{
+    t_reservation_slot  *slots;
+    int                 nbSlots;        // a power of 2
+    int                 nbReserved;
+    int                 maxReserved;    // half of the slots, to keep the probes short
+    uint32_t            generation;
+} t_reservation_table;
+
+/**
+ * @brief Function to create a reservation table
+ * @param maxReserved : the largest number of reservations held at the same time
+ * @return the table
+ */
+t_reservation_table createReservationTable(int);
+
+/**
+ * @brief Function to free a reservation table
+ * @param p_table : pointer to the table
+ * @return none
+ */
+void freeReservationTable(t_reservation_table *);
+
+/**
+ * @brief Function to remove all the reservations of a table, in constant time
+ * @param p_table : pointer to the table
+ * @return none
+ */
+void clearReservations(t_reservation_table *);
+
+/**
+ * @brief Function to reserve a cell at a time step for a robot
+ * @param p_table : pointer to the table
+ * @param pos : the position of the cell
+ * @param step : the time step
+ * @param robot : the index of the robot
+ * @return 1 if the slot is now held by the robot, 0 if another robot holds it
+ */
+int reserveCell(t_reservation_table *, t_position, int, int);
+
+/**
+ * @brief Function to find the robot holding a cell at a time step
+ * @param p_table : pointer to the table
+ * @param pos : the position of the cell
+ * @param step : the time step
+ * @return the index of the robot, -1 if the slot is free
+ */
+int getCellReservation(const t_reservation_table *, t_position, int);
+
+#endif //UNTITLED1_RESERVATION_H
@@ -0,0 +1,355 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "map.h"
+#include "results.h"
+
+/** layout of a results file (little endian, all sections aligned on 8 bytes) :
+ * - header : "MARCRES1", version (u32), rows of a full chunk (u32)
+ * - chunks : for n records, the columns seed (u64), x, y, phases, cost (i32), ori, outcome (u8)
+ * - footer : chunk offsets (u64), chunk rows (u32), then the trailer
+ * - trailer : footer offset, number of chunks, number of records (u64), "MARCEND1"
+ */
+#define RESULTS_MAGIC "MARCRES1"
+#define RESULTS_END_MAGIC "MARCEND1"
+#define RESULTS_VERSION 1
+#define RESULTS_HEADER_SIZE 16
+#define RESULTS_TRAILER_SIZE 32
+
+/**
+ * @brief Enum for the columns of a chunk, in the order they are stored
+ */
+typedef enum e_results_column
+{
+    COL_SEED,
+    COL_X,
+    COL_Y,
+    COL_PHASES,
+    COL_COST,
+    COL_ORI,
+    COL_OUTCOME,
+    NB_RESULTS_COLUMNS
+} t_results_column;
+
+/**
+ * @brief Array of the width in bytes of the columns, indexed by t_results_column
+ */
+static const int _column_width[NB_RESULTS_COLUMNS] = {8, 4, 4, 4, 4, 1, 1};
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to get the offset of a column in a chunk
+ * @param nbRows : the number of rows of the chunk
+ * @param column : the column
+ * @return the offset in bytes from the start of the chunk
+ */
+size_t getColumnOffset(int, t_results_column);
+
+/**
+ * @brief function to write a buffer at an offset of a file, exiting on error
+ * @param fd : the file descriptor
+ * @param buffer : the buffer
+ * @param size : the number of bytes
+ * @param offset : the offset in the file
+ * @return none
+ */
+void writeAt(int, const void *, size_t, uint64_t);
+
+/**
+ * @brief function to write the buffered records of a writer as a chunk
+ * @param p_writer : pointer to the writer
+ * @return none
+ */
+void flushResultsWriter(t_results_writer *);
+
+/* definition of local functions */
+
+size_t getColumnOffset(int nbRows, t_results_column column)
+{
+    size_t offset = 0;
+    for (int c = 0; c < (int)column; c++)
+    {
+        offset += (size_t)_column_width[c] * nbRows;
+    }
+    return offset;
+}
+
+void writeAt(int fd, const void *buffer, size_t size, uint64_t offset)
+{
+    const char *p = (const char *)buffer;
+    while (size > 0)
+    {
+        ssize_t written = pwrite(fd, p, size, (off_t)offset);
+        if (written <= 0)
+        {
+            fprintf(stderr, "Error: cannot write the results file\n");
+            exit(1);
+        }
+        p += written;
+        size -= written;
+        offset += written;
+    }
+    return;
+}
+
+void flushResultsWriter(t_results_writer *p_writer)
+{
+    int n = p_writer->nbRows;
+    if (n == 0)
+    {
+        return;
+    }
+    t_results_file *p_file = p_writer->file;
+    size_t size = (getColumnOffset(n, NB_RESULTS_COLUMNS) + 7) & ~(size_t)7;
+
+    // only the reservation of the space and the index entry are serialised
+    pthread_mutex_lock(&p_file->lock);
+    uint64_t offset = p_file->end;
+    p_file->end += size;
+    if (p_file->nbChunks == p_file->capacity)
+    {
+        p_file->capacity *= 2;
+        p_file->offsets = (uint64_t *)realloc(p_file->offsets, p_file->capacity * sizeof(uint64_t));
+        p_file->rows = (uint32_t *)realloc(p_file->rows, p_file->capacity * sizeof(uint32_t));
+    }
+    p_file->offsets[p_file->nbChunks] = offset;
+    p_file->rows[p_file->nbChunks] = (uint32_t)n;
+    p_file->nbChunks++;
+    p_file->nbRows += n;
+    pthread_mutex_unlock(&p_file->lock);
+
+    const void *columns[NB_RESULTS_COLUMNS] = {p_writer->seed, p_writer->x, p_writer->y, p_writer->phases,
+                                               p_writer->cost, p_writer->ori, p_writer->outcome};
+    for (int c = 0; c < NB_RESULTS_COLUMNS; c++)
+    {
+        writeAt(p_file->fd, columns[c], (size_t)_column_width[c] * n, offset + getColumnOffset(n, c));
+    }
+    p_writer->nbRows = 0;
+    return;
+}
+
+/* definitions of exported functions */
+
+t_results_file *createResultsFile(char *filename)
+{
+    int fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        fprintf(stderr, "Error: cannot open file %s\n", filename);
+        exit(1);
+    }
+    char header[RESULTS_HEADER_SIZE];
+    uint32_t version = RESULTS_VERSION;
+    uint32_t chunk_rows = RESULTS_CHUNK_ROWS;
+    memcpy(header, RESULTS_MAGIC, 8);
+    memcpy(header + 8, &version, 4);
+    memcpy(header + 12, &chunk_rows, 4);
+    writeAt(fd, header, RESULTS_HEADER_SIZE, 0);
+
+    t_results_file *p_file = (t_results_file *)malloc(sizeof(t_results_file));
+    p_file->fd = fd;
+    p_file->end = RESULTS_HEADER_SIZE;
+    p_file->capacity = 16;
+    p_file->offsets = (uint64_t *)malloc(p_file->capacity * sizeof(uint64_t));
+    p_file->rows = (uint32_t *)malloc(p_file->capacity * sizeof(uint32_t));
+    p_file->nbChunks = 0;
+    p_file->nbRows = 0;
+    pthread_mutex_init(&p_file->lock, NULL);
+    return p_file;
+}
+
+void closeResultsFile(t_results_file *p_file)
+{
+    uint64_t footer = p_file->end;
+    uint64_t offset = footer;
+    writeAt(p_file->fd, p_file->offsets, p_file->nbChunks * sizeof(uint64_t), offset);
+    offset += p_file->nbChunks * sizeof(uint64_t);
+    writeAt(p_file->fd, p_file->rows, p_file->nbChunks * sizeof(uint32_t), offset);
+    offset += (p_file->nbChunks * sizeof(uint32_t) + 7) & ~(uint64_t)7;
+
+    char trailer[RESULTS_TRAILER_SIZE];
+    uint64_t nbChunks = p_file->nbChunks;
+    memcpy(trailer, &footer, 8);
+    memcpy(trailer + 8, &nbChunks, 8);
+    memcpy(trailer + 16, &p_file->nbRows, 8);
+    memcpy(trailer + 24, RESULTS_END_MAGIC, 8);
+    writeAt(p_file->fd, trailer, RESULTS_TRAILER_SIZE, offset);
+    if (ftruncate(p_file->fd, (off_t)(offset + RESULTS_TRAILER_SIZE)) != 0 || close(p_file->fd) != 0)
+    {
+        fprintf(stderr, "Error: cannot close the results file\n");
+        exit(1);
+    }
+    pthread_mutex_destroy(&p_file->lock);
+    free(p_file->offsets);
+    free(p_file->rows);
+    free(p_file);
+    return;
+}
+
+t_results_writer createResultsWriter(t_results_file *p_file)
+{
+    t_results_writer writer;
+    writer.file = p_file;
+    writer.nbRows = 0;
+    writer.seed = (uint64_t *)malloc(RESULTS_CHUNK_ROWS * sizeof(uint64_t));
+    writer.x = (int32_t *)malloc(RESULTS_CHUNK_ROWS * sizeof(int32_t));
+    writer.y = (int32_t *)malloc(RESULTS_CHUNK_ROWS * sizeof(int32_t));
+    writer.ori = (uint8_t *)malloc(RESULTS_CHUNK_ROWS * sizeof(uint8_t));
+    writer.phases = (int32_t *)malloc(RESULTS_CHUNK_ROWS * sizeof(int32_t));
+    writer.outcome = (uint8_t *)malloc(RESULTS_CHUNK_ROWS * sizeof(uint8_t));
+    writer.cost = (int32_t *)malloc(RESULTS_CHUNK_ROWS * sizeof(int32_t));
+    return writer;
+}
+
+void appendResult(t_results_writer *p_writer, const t_mission_record *p_record)
+{
+    int i = p_writer->nbRows++;
+    p_writer->seed[i] = p_record->seed;
+    p_writer->x[i] = p_record->start.pos.x;
+    p_writer->y[i] = p_record->start.pos.y;
+    p_writer->ori[i] = (uint8_t)p_record->start.ori;
+    p_writer->phases[i] = p_record->nbPhases;
+    p_writer->outcome[i] = (uint8_t)p_record->outcome;
+    p_writer->cost[i] = p_record->finalCost;
+    if (p_writer->nbRows == RESULTS_CHUNK_ROWS)
+    {
+        flushResultsWriter(p_writer);
+    }
+    return;
+}
+
+void closeResultsWriter(t_results_writer *p_writer)
+{
+    flushResultsWriter(p_writer);
+    free(p_writer->seed);
+    free(p_writer->x);
+    free(p_writer->y);
+    free(p_writer->ori);
+    free(p_writer->phases);
+    free(p_writer->outcome);
+    free(p_writer->cost);
+    p_writer->file = NULL;
+    return;
+}
+
+t_results_view openResultsView(char *filename)
+{
+    t_results_view view;
+    int fd = open(filename, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0)
+    {
+        fprintf(stderr, "Error: cannot open file %s\n", filename);
+        exit(1);
+    }
+    view.size = (size_t)st.st_size;
+    if (view.size < RESULTS_HEADER_SIZE + RESULTS_TRAILER_SIZE)
+    {
+        fprintf(stderr, "Error: %s is not a results file\n", filename);
+        exit(1);
+    }
+    view.data = (const char *)mmap(NULL, view.size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view.data == MAP_FAILED)
+    {
+        fprintf(stderr, "Error: cannot map file %s\n", filename);
+        exit(1);
+    }
+    const char *trailer = view.data + view.size - RESULTS_TRAILER_SIZE;
+    uint64_t footer, nbChunks;
+    memcpy(&footer, trailer, 8);
+    memcpy(&nbChunks, trailer + 8, 8);
+    memcpy(&view.nbRows, trailer + 16, 8);
+    if (memcmp(view.data, RESULTS_MAGIC, 8) != 0 || memcmp(trailer + 24, RESULTS_END_MAGIC, 8) != 0
+        || footer + nbChunks * 12 > view.size - RESULTS_TRAILER_SIZE)
+    {
+        fprintf(stderr, "Error: %s is not a complete results file\n", filename);
+        exit(1);
+    }
+    view.nbChunks = (int)nbChunks;
+    view.offsets = (const uint64_t *)(view.data + footer);
+    view.rows = (const uint32_t *)(view.data + footer + nbChunks * sizeof(uint64_t));
+    return view;
+}
+
+void closeResultsView(t_results_view *p_view)
+{
+    munmap((void *)p_view->data, p_view->size);
+    p_view->data = NULL;
+    p_view->size = 0;
+    return;
+}
+
+t_results_chunk getResultsChunk(t_results_view view, int index)
+{
+    assert(index >= 0 && index < view.nbChunks);
+    t_results_chunk chunk;
+    int n = (int)view.rows[index];
+    const char *base = view.data + view.offsets[index];
+    chunk.nbRows = n;
+    chunk.seed = (const uint64_t *)(base + getColumnOffset(n, COL_SEED));
+    chunk.x = (const int32_t *)(base + getColumnOffset(n, COL_X));
+    chunk.y = (const int32_t *)(base + getColumnOffset(n, COL_Y));
+    chunk.phases = (const int32_t *)(base + getColumnOffset(n, COL_PHASES));
+    chunk.cost = (const int32_t *)(base + getColumnOffset(n, COL_COST));
+    chunk.ori = (const uint8_t *)(base + getColumnOffset(n, COL_ORI));
+    chunk.outcome = (const uint8_t *)(base + getColumnOffset(n, COL_OUTCOME));
+    return chunk;
+}
+
+t_mission_record getResultsRecord(t_results_chunk chunk, int row)
+{
+    assert(row >= 0 && row < chunk.nbRows);
+    t_mission_record record;
+    record.seed = chunk.seed[row];
+    record.start = loc_init(chunk.x[row], chunk.y[row], (t_orientation)chunk.ori[row]);
+    record.nbPhases = chunk.phases[row];
+    record.outcome = (t_outcome)chunk.outcome[row];
+    record.finalCost = chunk.cost[row];
+    return record;
+}
+
+t_results_summary summariseResults(t_results_view view)
+{
+    t_results_summary summary;
+    memset(&summary, 0, sizeof(t_results_summary));
+    uint64_t totalPhases = 0;
+    uint64_t totalCost = 0;
+    uint64_t nbCosts = 0;
+    // each loop reads a single column, so the scan stays sequential in memory
+    for (int c = 0; c < view.nbChunks; c++)
+    {
+        t_results_chunk chunk = getResultsChunk(view, c);
+        for (int i = 0; i < chunk.nbRows; i++)
+        {
+            summary.nbOutcomes[chunk.outcome[i] & 3]++;
+        }
+        for (int i = 0; i < chunk.nbRows; i++)
+        {
+            totalPhases += chunk.phases[i];
+        }
+        for (int i = 0; i < chunk.nbRows; i++)
+        {
+            if (chunk.cost[i] != COST_UNDEF)
+            {
+                totalCost += chunk.cost[i];
+                nbCosts++;
+            }
+        }
+        summary.nbMissions += chunk.nbRows;
+    }
+    summary.meanPhases = summary.nbMissions ? (double)totalPhases / summary.nbMissions : 0.0;
+    summary.meanFinalCost = nbCosts ? (double)totalCost / nbCosts : 0.0;
+    return summary;
+}
@@ -0,0 +1,186 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_RESULTS_H
+#define UNTITLED1_RESULTS_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "loc.h"
+
+/**
+ * @brief Number of records of a full chunk of a results file
+ */
+#define RESULTS_CHUNK_ROWS 65536
+
+/**
+ * @brief Enum for the outcome of a mission
+ */
+typedef enum e_outcome
+{
+    OUTCOME_BASE,       // the robot reached the base station
+    OUTCOME_CREVASSE,   // the robot fell into a crevasse
+    OUTCOME_OUT,        // the robot left the map
+    OUTCOME_TIMEOUT     // the robot was still moving after the maximal number of phases
+} t_outcome;
+
+/**
+ * @brief Structure for the record of a simulated mission
+ */
+typedef struct s_mission_record
+{
+    uint64_t        seed;
+    t_localisation  start;
+    int             nbPhases;
+    t_outcome       outcome;
+    int             finalCost;  // map.costs at the final localisation, COST_UNDEF out of the map
+} t_mission_record;
+
+/**
+ * @brief Structure for a results file being written
+ * the file is a header, chunks of fixed-width columns and a footer indexing the chunks :
+ * writers fill their own chunks and only take the lock to reserve the space and index them
+ */
+typedef struct s_results_file
+{
+    int             fd;
+    uint64_t        end;        // offset of the next chunk
+    uint64_t        *offsets;   // index of the chunks
+    uint32_t        *rows;
+    int             nbChunks;
+    int             capacity;
+    uint64_t        nbRows;
+    pthread_mutex_t lock;
+} t_results_file;
+
+/**
+ * @brief Structure for the buffered writer of a thread
+ */
+typedef struct s_results_writer
+{
+    t_results_file  *file;
+    int             nbRows;
+    uint64_t        *seed;
+    int32_t         *x;
+    int32_t         *y;
+    uint8_t         *ori;
+    int32_t         *phases;
+    uint8_t         *outcome;
+    int32_t         *cost;
+} t_results_writer;
+
+/**
+ * @brief Structure for a chunk of a results file : pointers to its columns
+ */
+typedef struct s_results_chunk
+{
+    int             nbRows;
+    const uint64_t  *seed;
+    const int32_t   *x;
+    const int32_t   *y;
+    const uint8_t   *ori;
+    const int32_t   *phases;
+    const uint8_t   *outcome;
+    const int32_t   *cost;
+} t_results_chunk;
+
+/**
+ * @brief Structure for a results file mapped in memory for reading
+ */
+typedef struct s_results_view
+{
+    const char      *data;
+    size_t          size;
+    int             nbChunks;
+    uint64_t        nbRows;
+    const uint64_t  *offsets;
+    const uint32_t  *rows;
+} t_results_view;
+
+/**
+ * @brief Structure for the aggregates of a scan of results
+ */
+typedef struct s_results_summary
+{
+    uint64_t    nbMissions;
+    uint64_t    nbOutcomes[4];  // indexed by t_outcome
+    double      meanPhases;
+    double      meanFinalCost;  // over the missions that did not leave the map
+} t_results_summary;
+
+/**
+ * @brief Function to create a results file
+ * @param filename : the name of the file
+ * @return pointer to the results file
+ */
+t_results_file *createResultsFile(char *);
+
+/**
+ * @brief Function to write the footer of a results file and close it (all writers must be flushed)
+ * @param p_file : pointer to the results file
+ * @return none
+ */
+void closeResultsFile(t_results_file *);
+
+/**
+ * @brief Function to create the buffered writer of a thread
+ * @param p_file : pointer to the results file
+ * @return the writer
+ */
+t_results_writer createResultsWriter(t_results_file *);
+
+/**
+ * @brief Function to append a record, the chunk is written when full
+ * @param p_writer : pointer to the writer
+ * @param p_record : pointer to the record
+ * @return none
+ */
+void appendResult(t_results_writer *, const t_mission_record *);
+
+/**
+ * @brief Function to write the buffered records of a writer and free it
+ * @param p_writer : pointer to the writer
+ * @return none
+ */
+void closeResultsWriter(t_results_writer *);
+
+/**
+ * @brief Function to map a results file for reading
+ * @param filename : the name of the file
+ * @return the view
+ */
+t_results_view openResultsView(char *);
+
+/**
+ * @brief Function to unmap a results file
+ * @param p_view : pointer to the view
+ * @return none
+ */
+void closeResultsView(t_results_view *);
+
+/**
+ * @brief Function to get the columns of a chunk of a results file
+ * @param view : the view
+ * @param index : the index of the chunk
+ * @return the chunk
+ */
+t_results_chunk getResultsChunk(t_results_view, int);
+
+/**
+ * @brief Function to get a record of a chunk
+ * @param chunk : the chunk
+ * @param row : the row of the record
+ * @return the record
+ */
+t_mission_record getResultsRecord(t_results_chunk, int);
+
+/**
+ * @brief Function to aggregate all the records of a results file, column by column
+ * @param view : the view
+ * @return the summary
+ */
+t_results_summary summariseResults(t_results_view);
+
+#endif //UNTITLED1_RESULTS_H
@@ -0,0 +1,177 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#define _GNU_SOURCE
+#include <assert.h>
+#include <malloc.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <time.h>
+#include "rt.h"
+
+/**
+ * @brief Size of the stack prefaulted when entering the real-time mode
+ */
+#define RT_STACK_PREFAULT (256 * 1024)
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to get the monotonic time (served by the vDSO, without system call)
+ * @return the time in nanoseconds
+ */
+long rtNow(void);
+
+/**
+ * @brief function to touch every page of the stack the phases may use
+ * @return none
+ */
+void prefaultStack(void);
+
+/* definition of local functions */
+
+long rtNow(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+void prefaultStack(void)
+{
+    char stack[RT_STACK_PREFAULT];
+    for (int i = 0; i < RT_STACK_PREFAULT; i += 4096)
+    {
+        stack[i] = 0;
+    }
+    // the array escapes to the barrier, so the compiler must keep the writes that touch the pages
+    __asm__ __volatile__("" : : "r"(stack) : "memory");
+    return;
+}
+
+/* definitions of exported functions */
+
+_Thread_local unsigned long _rt_nbAllocs = 0;
+
+unsigned long rtGetAllocCount(void)
+{
+    return _rt_nbAllocs;
+}
+
+t_rt rtInit(size_t arena_size)
+{
+    t_rt rt;
+    memset(&rt, 0, sizeof(t_rt));
+    // current and future pages stay in memory : later allocations are locked as soon as they are mapped
+    rt.locked = (mlockall(MCL_CURRENT | MCL_FUTURE) == 0);
+    if (!rt.locked)
+    {
+        fprintf(stderr, "Warning: cannot lock memory, page faults may happen during phases\n");
+    }
+    // freed memory stays in the heap and large blocks come from the heap too, so no mmap/munmap in phases
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+    prefaultStack();
+    rt.arena.base = (char *)mmap(NULL, arena_size, PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (rt.arena.base == MAP_FAILED)
+    {
+        fprintf(stderr, "Error: cannot map a real-time arena of %zu bytes\n", arena_size);
+        exit(1);
+    }
+    rt.arena.size = arena_size;
+    rt.arena.used = 0;
+    // the measures are taken once so their lazy bindings and the vDSO data are resolved before the first phase
+    struct rusage usage;
+    getrusage(RUSAGE_THREAD, &usage);
+    rt.phase_allocs = rtGetAllocCount();
+    rt.phase_start_ns = rtNow();
+    return rt;
+}
+
+void rtRelease(t_rt *p_rt)
+{
+    munmap(p_rt->arena.base, p_rt->arena.size);
+    p_rt->arena.base = NULL;
+    p_rt->arena.size = 0;
+    if (p_rt->locked)
+    {
+        munlockall();
+        p_rt->locked = 0;
+    }
+    return;
+}
+
+void *arenaAlloc(t_arena *p_arena, size_t size)
+{
+    size_t start = (p_arena->used + 63) & ~(size_t)63;
+    // the arena must be sized at startup for everything the controller needs
+    if (start + size > p_arena->size)
+    {
+        fprintf(stderr, "Error: real-time arena exhausted (%zu bytes requested)\n", size);
+        exit(1);
+    }
+    p_arena->used = start + size;
+    return p_arena->base + start;
+}
+
+void arenaReset(t_arena *p_arena)
+{
+    p_arena->used = 0;
+    return;
+}
+
+void rtBeginPhase(t_rt *p_rt)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_THREAD, &usage);
+    p_rt->phase_minflt = usage.ru_minflt;
+    p_rt->phase_majflt = usage.ru_majflt;
+    p_rt->phase_nvcsw = usage.ru_nvcsw;
+    p_rt->phase_allocs = rtGetAllocCount();
+    p_rt->phase_start_ns = rtNow();
+    return;
+}
+
+long rtEndPhase(t_rt *p_rt)
+{
+    long latency = rtNow() - p_rt->phase_start_ns;
+    unsigned long allocs = rtGetAllocCount();
+    struct rusage usage;
+    getrusage(RUSAGE_THREAD, &usage);
+    // a malloc freed before the end still counts; any fault means an untouched page (only avoidable once the
+    // memory is locked), a voluntary switch means a blocking system call
+    int faulted = (usage.ru_minflt != p_rt->phase_minflt) || (usage.ru_majflt != p_rt->phase_majflt);
+    int violation = (allocs != p_rt->phase_allocs)
+                    || (p_rt->locked && faulted)
+                    || (usage.ru_nvcsw != p_rt->phase_nvcsw);
+    if (violation)
+    {
+        p_rt->nbViolations++;
+    }
+    assert(!violation);
+    p_rt->nbPhases++;
+    p_rt->total_ns += latency;
+    if (latency > p_rt->worst_ns)
+    {
+        p_rt->worst_ns = latency;
+    }
+    return latency;
+}
+
+void rtReport(t_rt rt, FILE *file)
+{
+    fprintf(file, "Real-time phases: %ld (memory %slocked)\n", rt.nbPhases, rt.locked ? "" : "not ");
+    if (rt.nbPhases > 0)
+    {
+        fprintf(file, "  worst latency: %ld ns\n", rt.worst_ns);
+        fprintf(file, "  mean latency : %ld ns\n", rt.total_ns / rt.nbPhases);
+    }
+    fprintf(file, "  violations   : %ld\n", rt.nbViolations);
+    fprintf(file, "  arena usage  : %zu / %zu bytes\n", rt.arena.used, rt.arena.size);
+    return;
+}
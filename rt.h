@@ -0,0 +1,106 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_RT_H
+#define UNTITLED1_RT_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * @brief Structure for a memory arena : a locked and prefaulted mapping served by a bump pointer
+ */
+typedef struct s_arena
+{
+    char    *base;
+    size_t  size;
+    size_t  used;
+} t_arena;
+
+/**
+ * @brief Structure for the real-time mode of the controller
+ * phases are bracketed by rtBeginPhase / rtEndPhase, which measure their latency and check that the thread
+ * did not call the allocator and that no page fault nor blocking system call happened in between
+ */
+typedef struct s_rt
+{
+    t_arena arena;
+    int     locked;         // 1 if mlockall succeeded
+    long    nbPhases;
+    long    nbViolations;
+    long    worst_ns;
+    long    total_ns;
+    long    phase_start_ns;
+    unsigned long phase_allocs; // calls to the allocator made by the thread before the phase
+    long    phase_minflt;
+    long    phase_majflt;
+    long    phase_nvcsw;
+} t_rt;
+
+/**
+ * @brief Function to enter the real-time mode : locks the memory, prefaults the stack and the arena
+ * and stops the heap from giving memory back to the system
+ * @param arena_size : the size of the arena in bytes
+ * @return the real-time context
+ */
+t_rt rtInit(size_t);
+
+/**
+ * @brief Function to leave the real-time mode and unmap the arena
+ * @param p_rt : pointer to the real-time context
+ * @return none
+ */
+void rtRelease(t_rt *);
+
+/**
+ * @brief Function to allocate memory from the arena (never from the heap)
+ * @param p_arena : pointer to the arena
+ * @param size : the number of bytes
+ * @return pointer to the memory, aligned on 64 bytes
+ */
+void *arenaAlloc(t_arena *, size_t);
+
+/**
+ * @brief Function to free all the allocations of an arena at once
+ * @param p_arena : pointer to the arena
+ * @return none
+ */
+void arenaReset(t_arena *);
+
+/**
+ * @brief The number of calls to the allocator made by the current thread, counted by rtalloc.c in the programs
+ * linked with it (0 in the others)
+ */
+extern _Thread_local unsigned long _rt_nbAllocs;
+
+/**
+ * @brief Function to get the number of calls to the allocator made by the current thread (see _rt_nbAllocs)
+ * @return the number of calls
+ */
+unsigned long rtGetAllocCount(void);
+
+/**
+ * @brief Function to mark the start of a planning and simulation phase
+ * @param p_rt : pointer to the real-time context
+ * @return none
+ */
+void rtBeginPhase(t_rt *);
+
+/**
+ * @brief Function to mark the end of a phase, update the latency statistics and check the phase
+ * (asserts in debug builds that the phase did not allocate nor block, and did not fault if the memory is locked)
+ * @param p_rt : pointer to the real-time context
+ * @return the latency of the phase in nanoseconds
+ */
+long rtEndPhase(t_rt *);
+
+/**
+ * @brief Function to print the latency statistics of the phases
+ * @param rt : the real-time context
+ * @param file : the output file
+ * @return none
+ */
+void rtReport(t_rt, FILE *);
+
+#endif //UNTITLED1_RT_H
@@ -0,0 +1,68 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+/* counting allocator of the real-time mode (see rt.h) : linked only into the programs that check their phases,
+ * with -Wl,--wrap for each function below, so the calls of the program to the allocator come here and are counted
+ * in _rt_nbAllocs before going to the allocator of the C library (__real_xxx); the other programs keep the
+ * allocator untouched, and the calls made from inside the C library itself are not counted
+ */
+
+#define _GNU_SOURCE
+#include <malloc.h>
+#include <stdlib.h>
+#include "rt.h"
+
+/* the functions wrapped, under the names the linker gives them */
+void *__real_malloc(size_t);
+void *__real_calloc(size_t, size_t);
+void *__real_realloc(void *, size_t);
+void __real_free(void *);
+int __real_posix_memalign(void **, size_t, size_t);
+void *__real_aligned_alloc(size_t, size_t);
+void *__real_memalign(size_t, size_t);
+
+/* definitions of exported functions */
+
+void *__wrap_malloc(size_t size)
+{
+    _rt_nbAllocs++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t nb, size_t size)
+{
+    _rt_nbAllocs++;
+    return __real_calloc(nb, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    _rt_nbAllocs++;
+    return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void *ptr)
+{
+    _rt_nbAllocs++;
+    __real_free(ptr);
+    return;
+}
+
+int __wrap_posix_memalign(void **p_ptr, size_t alignment, size_t size)
+{
+    _rt_nbAllocs++;
+    return __real_posix_memalign(p_ptr, alignment, size);
+}
+
+void *__wrap_aligned_alloc(size_t alignment, size_t size)
+{
+    _rt_nbAllocs++;
+    return __real_aligned_alloc(alignment, size);
+}
+
+void *__wrap_memalign(size_t alignment, size_t size)
+{
+    _rt_nbAllocs++;
+    return __real_memalign(alignment, size);
+}
@@ -0,0 +1,106 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cpu.h"
+#include "soilscan.h"
+
+/**
+ * @brief Number of invalid cells listed by checkSoilScan, the others are only counted
+ */
+#define SOILSCAN_MAX_REPORTED 10
+
+/* definitions of exported functions */
+
+t_soil_scan scanSoils(t_map map)
+{
+    t_soil_scan scan;
+    memset(scan.histogram, 0, sizeof(scan.histogram));
+    scan.nbBases = 0;
+    scan.nbInvalid = 0;
+    int capacityBases = 4, capacityInvalid = 4;
+    scan.bases = (t_position *)malloc(capacityBases * sizeof(t_position));
+    scan.invalid = (t_position *)malloc(capacityInvalid * sizeof(t_position));
+    scan.invalidValues = (int *)malloc(capacityInvalid * sizeof(int));
+    int *columns = (int *)malloc((map.x_max > 0 ? map.x_max : 1) * sizeof(int));
+    for (int y = 0; y < map.y_max; y++)
+    {
+        // only the base stations and the invalid cells come out of the kernel : a few per map
+        int nb = _kernels.scanSoilRow(map.soils[y], map.x_max, scan.histogram, columns);
+        for (int i = 0; i < nb; i++)
+        {
+            t_position pos;
+            pos.x = columns[i];
+            pos.y = y;
+            if (map.soils[y][pos.x] == BASE_STATION)
+            {
+                if (scan.nbBases == capacityBases)
+                {
+                    capacityBases *= 2;
+                    scan.bases = (t_position *)realloc(scan.bases, capacityBases * sizeof(t_position));
+                }
+                scan.bases[scan.nbBases++] = pos;
+            }
+            else
+            {
+                if (scan.nbInvalid == capacityInvalid)
+                {
+                    capacityInvalid *= 2;
+                    scan.invalid = (t_position *)realloc(scan.invalid, capacityInvalid * sizeof(t_position));
+                    scan.invalidValues = (int *)realloc(scan.invalidValues, capacityInvalid * sizeof(int));
+                }
+                scan.invalid[scan.nbInvalid] = pos;
+                scan.invalidValues[scan.nbInvalid++] = (int)map.soils[y][pos.x];
+            }
+        }
+    }
+    free(columns);
+    return scan;
+}
+
+t_soil_summary getSoilSummary(const t_soil_scan *p_scan)
+{
+    t_soil_summary summary;
+    memcpy(summary.counts, p_scan->histogram, sizeof(summary.counts));
+    summary.nbBases = p_scan->nbBases;
+    summary.base.x = -1;
+    summary.base.y = -1;
+    if (p_scan->nbBases > 0)
+    {
+        summary.base = p_scan->bases[0];
+    }
+    return summary;
+}
+
+void freeSoilScan(t_soil_scan *p_scan)
+{
+    free(p_scan->bases);
+    free(p_scan->invalid);
+    free(p_scan->invalidValues);
+    p_scan->bases = NULL;
+    p_scan->invalid = NULL;
+    p_scan->invalidValues = NULL;
+    return;
+}
+
+void checkSoilScan(const t_soil_scan *p_scan, char *name)
+{
+    if (p_scan->nbInvalid == 0)
+    {
+        return;
+    }
+    fprintf(stderr, "Error: map %s has %d cells that are not a soil (0 to %d)\n", name, p_scan->nbInvalid, CREVASSE);
+    for (int i = 0; i < p_scan->nbInvalid && i < SOILSCAN_MAX_REPORTED; i++)
+    {
+        fprintf(stderr, "  line %d, column %d : %d\n", p_scan->invalid[i].y, p_scan->invalid[i].x,
+                p_scan->invalidValues[i]);
+    }
+    if (p_scan->nbInvalid > SOILSCAN_MAX_REPORTED)
+    {
+        fprintf(stderr, "  ... and %d more\n", p_scan->nbInvalid - SOILSCAN_MAX_REPORTED);
+    }
+    exit(1);
+}
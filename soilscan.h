@@ -0,0 +1,54 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_SOILSCAN_H
+#define UNTITLED1_SOILSCAN_H
+
+#include "loc.h"
+#include "map.h"
+
+/**
+ * @brief Structure for the result of a scan of the soils of a map
+ */
+typedef struct s_soil_scan
+{
+    int         histogram[CREVASSE + 1];    // number of cells of each soil
+    t_position  *bases;                     // the base stations, row by row
+    int         nbBases;
+    t_position  *invalid;                   // the cells whose value is not a soil, row by row
+    int         *invalidValues;             // the value of each of them
+    int         nbInvalid;
+} t_soil_scan;
+
+/**
+ * @brief Function to scan the soils of a map in one pass (with the SIMD kernel of the CPU) : counts the soils,
+ * finds the base stations and the cells whose value is not a soil
+ * @param map : the map
+ * @return the scan
+ */
+t_soil_scan scanSoils(t_map);
+
+/**
+ * @brief Function to get the summary of a scan kept with a map (see t_soil_summary)
+ * @param p_scan : pointer to the scan
+ * @return the summary
+ */
+t_soil_summary getSoilSummary(const t_soil_scan *);
+
+/**
+ * @brief Function to free the arrays of a scan
+ * @param p_scan : pointer to the scan
+ * @return none
+ */
+void freeSoilScan(t_soil_scan *);
+
+/**
+ * @brief Function to report the invalid cells of a scan on stderr and exit if there are some
+ * @param p_scan : pointer to the scan
+ * @param name : the name of the map, for the messages
+ * @return none
+ */
+void checkSoilScan(const t_soil_scan *, char *);
+
+#endif //UNTITLED1_SOILSCAN_H
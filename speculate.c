@@ -0,0 +1,351 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <assert.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include "speculate.h"
+
+/**
+ * @brief Number of slots probed when looking for an entry of the cache
+ */
+#define SPEC_MAX_PROBES 8
+
+/**
+ * @brief Number of failed tries to take the lock of the speculator before yielding the CPU between tries
+ */
+#define SPEC_SPINS_BEFORE_YIELD 64
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to take the lock of the speculator by spinning instead of sleeping : the thread of the mission
+ * must not block in a phase (see rt.h), and the workers only hold the lock for a few stores
+ * @param p_spec : pointer to the speculator
+ * @return none
+ */
+void lockSpeculator(t_speculator *);
+
+/**
+ * @brief function to hash a (localisation, draw) key
+ * @param loc : the localisation
+ * @param draw : the key of the draw
+ * @return the hash
+ */
+unsigned int hashSpecKey(t_localisation, t_draw_key);
+
+/**
+ * @brief function to find the entry of a key, or a slot to store it
+ * @param p_spec : pointer to the speculator (locked)
+ * @param loc : the localisation
+ * @param draw : the key of the draw
+ * @param insert : 1 to get a free (or evictable) slot when the key is absent
+ * @return the index of the entry, -1 if there is none
+ */
+int findSpecEntry(t_speculator *, t_localisation, t_draw_key, int);
+
+/**
+ * @brief function to drop the jobs that were not started yet
+ * @param p_spec : pointer to the speculator (locked)
+ * @return none
+ */
+void dropPendingJobs(t_speculator *);
+
+/**
+ * @brief task planning a pending entry of the cache
+ * @param arg : pointer to the t_spec_job of the entry
+ * @return none
+ */
+void speculativeTask(void *);
+
+/* definition of local functions */
+
+void lockSpeculator(t_speculator *p_spec)
+{
+    int spins = 0;
+    while (pthread_mutex_trylock(&p_spec->lock) != 0)
+    {
+        // the holder is a few stores away : pause the pipeline, then give it the CPU if it was preempted
+        if (++spins < SPEC_SPINS_BEFORE_YIELD)
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+    return;
+}
+
+unsigned int hashSpecKey(t_localisation loc, t_draw_key draw)
+{
+    unsigned int h = draw * 2654435761u;
+    h ^= (unsigned int)loc.pos.x * 0x9E3779B1u;
+    h = (h << 13) | (h >> 19);
+    h ^= (unsigned int)loc.pos.y * 0x85EBCA77u;
+    h ^= (unsigned int)loc.ori * 0xC2B2AE3Du;
+    return h ^ (h >> 16);
+}
+
+int findSpecEntry(t_speculator *p_spec, t_localisation loc, t_draw_key draw, int insert)
+{
+    unsigned int h = hashSpecKey(loc, draw);
+    int free_slot = -1;
+    for (int p = 0; p < SPEC_MAX_PROBES; p++)
+    {
+        int idx = (int)((h + p) & (p_spec->capacity - 1));
+        t_spec_entry *e = &p_spec->entries[idx];
+        if (e->state == SPEC_EMPTY)
+        {
+            if (free_slot < 0 || p_spec->entries[free_slot].state != SPEC_EMPTY)
+            {
+                free_slot = idx;
+            }
+            continue;
+        }
+        if (e->draw == draw && e->loc.pos.x == loc.pos.x && e->loc.pos.y == loc.pos.y && e->loc.ori == loc.ori)
+        {
+            return idx;
+        }
+        // a finished plan can be evicted, but an empty slot is preferred
+        if (e->state == SPEC_DONE && free_slot < 0)
+        {
+            free_slot = idx;
+        }
+    }
+    return insert ? free_slot : -1;
+}
+
+void dropPendingJobs(t_speculator *p_spec)
+{
+    for (int i = 0; i < p_spec->nbPending; i++)
+    {
+        t_spec_entry *e = &p_spec->entries[p_spec->pending[i]];
+        if (e->state == SPEC_PENDING)
+        {
+            e->state = SPEC_EMPTY;
+        }
+    }
+    p_spec->nbPending = 0;
+    return;
+}
+
+void speculativeTask(void *arg)
+{
+    t_spec_job *p_job = (t_spec_job *)arg;
+    t_speculator *p_spec = p_job->spec;
+    t_spec_entry *e = &p_spec->entries[p_job->index];
+    atomic_fetch_sub(&p_spec->nbQueued, 1);
+    pthread_mutex_lock(&p_spec->lock);
+    // the entry was dropped, or is already handled by another task
+    if (e->state != SPEC_PENDING)
+    {
+        pthread_mutex_unlock(&p_spec->lock);
+        return;
+    }
+    e->state = SPEC_RUNNING;
+    atomic_store(&e->cancel, 0);
+    t_localisation loc = e->loc;
+    t_move draw[PLAN_MAX_MOVES];
+    int nbDraw = getDrawFromKey(e->draw, draw);
+    pthread_mutex_unlock(&p_spec->lock);
+
+    t_plan plan;
+    int found = planTopKCancellable(p_spec->planner, loc, draw, nbDraw, p_spec->nbChoose, &plan, 1, &e->cancel);
+
+    pthread_mutex_lock(&p_spec->lock);
+    if (found < 0)
+    {
+        e->state = SPEC_EMPTY;
+        p_spec->cancelled++;
+    }
+    else
+    {
+        e->plan = plan;
+        e->found = found;
+        e->state = SPEC_DONE;
+    }
+    pthread_mutex_unlock(&p_spec->lock);
+    return;
+}
+
+/* definitions of exported functions */
+
+t_speculator *createSpeculator(const t_planner *p_planner, int nbDraw, int nbChoose, t_pool *p_pool, int capacity)
+{
+    assert(nbDraw > 0 && nbDraw <= PLAN_MAX_MOVES);
+    assert(capacity > 0);
+    t_speculator *p_spec = (t_speculator *)malloc(sizeof(t_speculator));
+    p_spec->planner = p_planner;
+    p_spec->nbDraw = nbDraw;
+    p_spec->nbChoose = nbChoose;
+    p_spec->capacity = SPEC_MAX_PROBES;
+    while (p_spec->capacity < capacity)
+    {
+        p_spec->capacity *= 2;
+    }
+    p_spec->entries = (t_spec_entry *)calloc(p_spec->capacity, sizeof(t_spec_entry));
+    for (int i = 0; i < p_spec->capacity; i++)
+    {
+        p_spec->entries[i].state = SPEC_EMPTY;
+        atomic_init(&p_spec->entries[i].cancel, 0);
+    }
+    p_spec->ranked = (t_draw_key *)malloc(p_spec->capacity * sizeof(t_draw_key));
+    p_spec->nbRanked = getMostProbableDraws(nbDraw, p_spec->ranked, p_spec->capacity);
+    p_spec->jobs = (t_spec_job *)malloc(p_spec->capacity * sizeof(t_spec_job));
+    for (int i = 0; i < p_spec->capacity; i++)
+    {
+        p_spec->jobs[i].spec = p_spec;
+        p_spec->jobs[i].index = i;
+    }
+    p_spec->pending = (int *)malloc(p_spec->capacity * sizeof(int));
+    p_spec->nbPending = 0;
+    p_spec->pool = p_pool;
+    initTaskGroup(&p_spec->group);
+    atomic_init(&p_spec->nbQueued, 0);
+    p_spec->hits = 0;
+    p_spec->misses = 0;
+    p_spec->cancelled = 0;
+    pthread_mutex_init(&p_spec->lock, NULL);
+    return p_spec;
+}
+
+void freeSpeculator(t_speculator *p_spec)
+{
+    pthread_mutex_lock(&p_spec->lock);
+    dropPendingJobs(p_spec);
+    for (int i = 0; i < p_spec->capacity; i++)
+    {
+        atomic_store(&p_spec->entries[i].cancel, 1);
+    }
+    pthread_mutex_unlock(&p_spec->lock);
+    // the tasks still queued reference the speculator
+    waitTaskGroup(p_spec->pool, &p_spec->group);
+    destroyTaskGroup(&p_spec->group);
+    pthread_mutex_destroy(&p_spec->lock);
+    free(p_spec->pending);
+    free(p_spec->jobs);
+    free(p_spec->ranked);
+    free(p_spec->entries);
+    free(p_spec);
+    return;
+}
+
+int speculate(t_speculator *p_spec, t_localisation loc, int nbDraws)
+{
+    // no allocation nor ranking here : the draws were ranked at creation
+    t_draw_key *keys = p_spec->ranked;
+    if (nbDraws > p_spec->nbRanked)
+    {
+        nbDraws = p_spec->nbRanked;
+    }
+    int nbQueued = 0;
+    pthread_mutex_lock(&p_spec->lock);
+    dropPendingJobs(p_spec);
+    // the tasks of dropped jobs are still in the queues of the pool until a worker skips them
+    int room = p_spec->capacity - atomic_load(&p_spec->nbQueued);
+    for (int i = 0; i < nbDraws && p_spec->nbPending < room; i++)
+    {
+        int idx = findSpecEntry(p_spec, loc, keys[i], 1);
+        if (idx < 0)
+        {
+            continue;
+        }
+        t_spec_entry *e = &p_spec->entries[idx];
+        // a plan already computed (or being computed) for this key is kept
+        if (e->state != SPEC_EMPTY && e->draw == keys[i] && e->loc.pos.x == loc.pos.x
+            && e->loc.pos.y == loc.pos.y && e->loc.ori == loc.ori)
+        {
+            continue;
+        }
+        e->loc = loc;
+        e->draw = keys[i];
+        e->state = SPEC_PENDING;
+        p_spec->pending[p_spec->nbPending++] = idx;
+    }
+    nbQueued = p_spec->nbPending;
+    atomic_fetch_add(&p_spec->nbQueued, nbQueued);
+    pthread_mutex_unlock(&p_spec->lock);
+    for (int i = 0; i < nbQueued; i++)
+    {
+        submitTask(p_spec->pool, &p_spec->group, speculativeTask, &p_spec->jobs[p_spec->pending[i]]);
+    }
+    return nbQueued;
+}
+
+int speculativePlan(t_speculator *p_spec, t_localisation loc, const t_move *draw, t_plan *p_plan)
+{
+    t_draw_key key = getDrawKey(draw, p_spec->nbDraw);
+    lockSpeculator(p_spec);
+    dropPendingJobs(p_spec);
+    int idx = findSpecEntry(p_spec, loc, key, 0);
+    // the work on other draws is useless now, and the draw itself is not waited for (its worker may not run
+    // before the deadline of the phase) : it is planned below
+    for (int i = 0; i < p_spec->capacity; i++)
+    {
+        if (p_spec->entries[i].state == SPEC_RUNNING)
+        {
+            atomic_store(&p_spec->entries[i].cancel, 1);
+        }
+    }
+    if (idx >= 0)
+    {
+        t_spec_entry *e = &p_spec->entries[idx];
+        if (e->state == SPEC_DONE && e->draw == key && e->loc.pos.x == loc.pos.x
+            && e->loc.pos.y == loc.pos.y && e->loc.ori == loc.ori)
+        {
+            int found = e->found;
+            *p_plan = e->plan;
+            p_spec->hits++;
+            pthread_mutex_unlock(&p_spec->lock);
+            return found;
+        }
+    }
+    p_spec->misses++;
+    pthread_mutex_unlock(&p_spec->lock);
+
+    // cache miss : plan the draw synchronously and keep the result
+    int found = planBest(p_spec->planner, loc, draw, p_spec->nbDraw, p_spec->nbChoose, p_plan);
+    lockSpeculator(p_spec);
+    idx = findSpecEntry(p_spec, loc, key, 1);
+    if (idx >= 0 && p_spec->entries[idx].state != SPEC_RUNNING)
+    {
+        t_spec_entry *e = &p_spec->entries[idx];
+        e->loc = loc;
+        e->draw = key;
+        e->plan = *p_plan;
+        e->found = found;
+        e->state = SPEC_DONE;
+    }
+    pthread_mutex_unlock(&p_spec->lock);
+    return found;
+}
+
+int speculativeStrategy(t_map map, t_localisation loc, const t_move *draw, int nbDraw, int nbChoose, t_move *chosen, void *ctx)
+{
+    (void)map;
+    (void)nbDraw;
+    (void)nbChoose;
+    t_speculator *p_spec = (t_speculator *)ctx;
+    assert(nbDraw == p_spec->nbDraw && nbChoose == p_spec->nbChoose);
+    t_plan plan;
+    if (!speculativePlan(p_spec, loc, draw, &plan))
+    {
+        return 0;
+    }
+    memcpy(chosen, plan.moves, plan.nbMoves * sizeof(t_move));
+    return plan.nbMoves;
+}
+
+void speculateNextPhase(t_localisation loc, void *ctx)
+{
+    t_speculator *p_spec = (t_speculator *)ctx;
+    speculate(p_spec, loc, p_spec->nbRanked);
+    return;
+}
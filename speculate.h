@@ -0,0 +1,135 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_SPECULATE_H
+#define UNTITLED1_SPECULATE_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include "draw.h"
+#include "planner.h"
+#include "pool.h"
+
+/**
+ * @brief Enum for the state of an entry of the speculative cache
+ */
+typedef enum e_spec_state
+{
+    SPEC_EMPTY,
+    SPEC_PENDING,   // waiting for a worker
+    SPEC_RUNNING,   // being planned by a worker
+    SPEC_DONE       // plan available
+} t_spec_state;
+
+/**
+ * @brief Structure for an entry of the speculative cache, keyed by (localisation, draw)
+ */
+typedef struct s_spec_entry
+{
+    t_localisation  loc;
+    t_draw_key      draw;
+    t_spec_state    state;
+    int             found;      // 0 if every sequence of the draw is fatal
+    t_plan          plan;
+    atomic_int      cancel;
+} t_spec_entry;
+
+/**
+ * @brief Structure for the argument of the task planning an entry
+ */
+typedef struct s_spec_job
+{
+    struct s_speculator *spec;
+    int                 index;
+} t_spec_job;
+
+/**
+ * @brief Structure for the speculative planner
+ * tasks of a thread pool plan the most probable next draws while the robot executes its moves;
+ * the cache is an open addressing table under lock, a task skips its entry when it is no longer pending;
+ * speculativePlan never sleeps nor allocates, so it can run in a real-time phase; speculate is called between
+ * phases (see speculateNextPhase) and does not allocate once the queues of the pool can hold capacity tasks
+ */
+typedef struct s_speculator
+{
+    const t_planner *planner;
+    int             nbDraw;
+    int             nbChoose;
+    t_draw_key      *ranked;    // draws of nbDraw moves, most probable first, ranked once at creation
+    int             nbRanked;
+    t_spec_entry    *entries;
+    int             capacity;   // power of two
+    t_spec_job      *jobs;      // jobs[i] is the argument of the tasks planning entries[i]
+    int             *pending;   // indices of the entries queued by the last speculation
+    int             nbPending;
+    t_pool          *pool;
+    t_task_group    group;
+    atomic_int      nbQueued;   // tasks submitted and not started yet, at most capacity
+    pthread_mutex_t lock;
+    long            hits;
+    long            misses;
+    long            cancelled;
+} t_speculator;
+
+/**
+ * @brief Function to create a speculative planner
+ * @param p_planner : pointer to the planner, shared read-only by the tasks
+ * @param nbDraw : the number of moves drawn per phase
+ * @param nbChoose : the maximal number of moves chosen per phase
+ * @param p_pool : pointer to the thread pool running the speculative tasks
+ * @param capacity : the number of entries of the cache (rounded up to a power of two)
+ * @return pointer to the speculator
+ */
+t_speculator *createSpeculator(const t_planner *, int, int, t_pool *, int);
+
+/**
+ * @brief Function to cancel the tasks of a speculative planner, wait for them and free it
+ * @param p_spec : pointer to the speculator
+ * @return none
+ */
+void freeSpeculator(t_speculator *);
+
+/**
+ * @brief Function to start planning the most probable draws of the next phase
+ * pending work of a previous speculation is dropped, finished plans stay in the cache
+ * @param p_spec : pointer to the speculator
+ * @param loc : the expected localisation at the end of the current phase
+ * @param nbDraws : the number of most probable draws to plan
+ * @return the number of draws queued
+ */
+int speculate(t_speculator *, t_localisation, int);
+
+/**
+ * @brief Function to get the plan of the actual draw, cancelling the speculative work that no longer matters
+ * the caller never waits for a worker : a draw whose plan is still running is cancelled and planned by the caller
+ * @param p_spec : pointer to the speculator
+ * @param loc : the actual localisation of the robot
+ * @param draw : the moves actually drawn
+ * @param p_plan : pointer to the plan receiving the result
+ * @return 1 if a plan was found, 0 if every sequence is fatal
+ */
+int speculativePlan(t_speculator *, t_localisation, const t_move *, t_plan *);
+
+/**
+ * @brief Function to get the strategy of a speculative planner : the plan of the draw from the cache
+ * @param map : the map (unused, the planner of the speculator holds it)
+ * @param loc : the localisation of the robot
+ * @param draw : the moves drawn
+ * @param nbDraw : the number of moves drawn, the one of the speculator
+ * @param nbChoose : the maximal number of moves to choose, the one of the speculator
+ * @param chosen : array receiving the moves
+ * @param ctx : pointer to the t_speculator
+ * @return the number of moves chosen
+ */
+int speculativeStrategy(t_map, t_localisation, const t_move *, int, int, t_move *, void *);
+
+/**
+ * @brief Function to start planning the most probable draws of the next phase of a mission (see t_phase_end)
+ * @param loc : the localisation of the robot at the end of the phase
+ * @param ctx : pointer to the t_speculator
+ * @return none
+ */
+void speculateNextPhase(t_localisation, void *);
+
+#endif //UNTITLED1_SPECULATE_H
@@ -0,0 +1,244 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+/* test of the SIMD kernels of cpu.c : every level the CPU supports is bound in turn (as MARC_CPU_LEVEL does)
+ * and its kernels are compared with the scalar ones on random rows and blocks, the row lengths covering the
+ * tails that do not fill a vector
+ * usage : test_kernels (exit status 0 if every kernel matches)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cpu.h"
+#include "draw.h"
+
+/**
+ * @brief Longest row tested, the rows of 0 to TEST_MAX_ROW cells are all tested
+ */
+#define TEST_MAX_ROW 100
+
+/**
+ * @brief Number of random rows or blocks tested per length or width
+ */
+#define TEST_ROUNDS 200
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to bind the kernels of a level
+ * @param level : the level
+ * @return the kernels
+ */
+t_kernels bindKernels(t_cpu_level);
+
+/**
+ * @brief function to fill a row with random soils, a few of them invalid
+ * @param p_rng : pointer to the generator
+ * @param soils : the row
+ * @param n : the number of cells
+ * @return none
+ */
+void randomSoils(t_rng *, t_soil *, int);
+
+/**
+ * @brief function to compare the rowMinFalseCrevasse kernels of a level with the scalar one
+ * @param p_ref : pointer to the scalar kernels
+ * @param p_test : pointer to the kernels of the level
+ * @param p_rng : pointer to the generator
+ * @return the number of mismatches
+ */
+int testRowMinFalseCrevasse(const t_kernels *, const t_kernels *, t_rng *);
+
+/**
+ * @brief function to compare the rowMin5 kernels of a level with the scalar one
+ * @param p_ref : pointer to the scalar kernels
+ * @param p_test : pointer to the kernels of the level
+ * @param p_rng : pointer to the generator
+ * @return the number of mismatches
+ */
+int testRowMin5(const t_kernels *, const t_kernels *, t_rng *);
+
+/**
+ * @brief function to compare the decodeDeltas kernels of a level with the scalar one
+ * @param p_ref : pointer to the scalar kernels
+ * @param p_test : pointer to the kernels of the level
+ * @param p_rng : pointer to the generator
+ * @return the number of mismatches
+ */
+int testDecodeDeltas(const t_kernels *, const t_kernels *, t_rng *);
+
+/**
+ * @brief function to compare the scanSoilRow kernels of a level with the scalar one
+ * @param p_ref : pointer to the scalar kernels
+ * @param p_test : pointer to the kernels of the level
+ * @param p_rng : pointer to the generator
+ * @return the number of mismatches
+ */
+int testScanSoilRow(const t_kernels *, const t_kernels *, t_rng *);
+
+/* definition of local functions */
+
+t_kernels bindKernels(t_cpu_level level)
+{
+    setenv("MARC_CPU_LEVEL", getCpuLevelName(level), 1);
+    initCpuDispatch();
+    return _kernels;
+}
+
+void randomSoils(t_rng *p_rng, t_soil *soils, int n)
+{
+    static const int invalid[3] = {-1, CREVASSE + 1, 9};
+    for (int j = 0; j < n; j++)
+    {
+        int r = randomBelow(p_rng, 40);
+        soils[j] = (r == 0) ? (t_soil)invalid[randomBelow(p_rng, 3)] : (t_soil)(r % (CREVASSE + 1));
+    }
+    return;
+}
+
+int testRowMinFalseCrevasse(const t_kernels *p_ref, const t_kernels *p_test, t_rng *p_rng)
+{
+    int nbErrors = 0;
+    t_soil soils[TEST_MAX_ROW];
+    int costs[TEST_MAX_ROW];
+    for (int n = 0; n <= TEST_MAX_ROW; n++)
+    {
+        for (int round = 0; round < TEST_ROUNDS; round++)
+        {
+            randomSoils(p_rng, soils, n);
+            for (int j = 0; j < n; j++)
+            {
+                // small costs so that equal minimums happen, and some cells never reached
+                costs[j] = (randomBelow(p_rng, 10) == 0) ? COST_UNDEF : randomBelow(p_rng, 60);
+            }
+            int threshold = randomBelow(p_rng, 30);
+            int start = (randomBelow(p_rng, 2) == 0) ? COST_UNDEF : randomBelow(p_rng, 60);
+            int ref_min = start, test_min = start;
+            int ref = p_ref->rowMinFalseCrevasse(soils, costs, n, threshold, &ref_min);
+            int test = p_test->rowMinFalseCrevasse(soils, costs, n, threshold, &test_min);
+            if (ref != test || ref_min != test_min)
+            {
+                fprintf(stderr, "rowMinFalseCrevasse : n = %d, column %d instead of %d, minimum %d instead of %d\n",
+                        n, test, ref, test_min, ref_min);
+                nbErrors++;
+            }
+        }
+    }
+    return nbErrors;
+}
+
+int testRowMin5(const t_kernels *p_ref, const t_kernels *p_test, t_rng *p_rng)
+{
+    int nbErrors = 0;
+    int up[TEST_MAX_ROW], row[TEST_MAX_ROW], down[TEST_MAX_ROW], ref[TEST_MAX_ROW], test[TEST_MAX_ROW];
+    for (int n = 0; n <= TEST_MAX_ROW; n++)
+    {
+        for (int round = 0; round < TEST_ROUNDS; round++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                up[j] = randomBelow(p_rng, COST_UNDEF + 1);
+                row[j] = randomBelow(p_rng, COST_UNDEF + 1);
+                down[j] = randomBelow(p_rng, COST_UNDEF + 1);
+            }
+            // the first and the last rows of a map have no row above or below
+            const int *p_up = (round % 4 == 1) ? NULL : up;
+            const int *p_down = (round % 4 == 2) ? NULL : down;
+            p_ref->rowMin5(p_up, row, p_down, ref, n);
+            p_test->rowMin5(p_up, row, p_down, test, n);
+            if (n > 0 && memcmp(ref, test, n * sizeof(int)) != 0)
+            {
+                fprintf(stderr, "rowMin5 : n = %d, rows above %s and below %s differ\n", n,
+                        (p_up != NULL) ? "given" : "NULL", (p_down != NULL) ? "given" : "NULL");
+                nbErrors++;
+            }
+        }
+    }
+    return nbErrors;
+}
+
+int testDecodeDeltas(const t_kernels *p_ref, const t_kernels *p_test, t_rng *p_rng)
+{
+    static const int widths[5] = {0, 4, 8, 16, 32};
+    int nbErrors = 0;
+    unsigned char deltas[DELTA_BLOCK_CELLS * 4];
+    int ref[DELTA_BLOCK_CELLS], test[DELTA_BLOCK_CELLS];
+    for (int w = 0; w < 5; w++)
+    {
+        for (int round = 0; round < TEST_ROUNDS; round++)
+        {
+            for (int i = 0; i < (int)sizeof(deltas); i++)
+            {
+                deltas[i] = (unsigned char)randomBelow(p_rng, 256);
+            }
+            if (widths[w] == 32)
+            {
+                // deltas of 32 bits stay under 2^24 so that the base plus the delta is an int
+                for (int i = 0; i < DELTA_BLOCK_CELLS; i++)
+                {
+                    deltas[4 * i + 3] = 0;
+                }
+            }
+            int base = randomBelow(p_rng, COST_UNDEF);
+            p_ref->decodeDeltas(deltas, widths[w], base, ref);
+            p_test->decodeDeltas(deltas, widths[w], base, test);
+            if (memcmp(ref, test, sizeof(ref)) != 0)
+            {
+                fprintf(stderr, "decodeDeltas : width %d, base %d differ\n", widths[w], base);
+                nbErrors++;
+            }
+        }
+    }
+    return nbErrors;
+}
+
+int testScanSoilRow(const t_kernels *p_ref, const t_kernels *p_test, t_rng *p_rng)
+{
+    int nbErrors = 0;
+    t_soil soils[TEST_MAX_ROW];
+    int ref_columns[TEST_MAX_ROW], test_columns[TEST_MAX_ROW];
+    for (int n = 0; n <= TEST_MAX_ROW; n++)
+    {
+        for (int round = 0; round < TEST_ROUNDS; round++)
+        {
+            randomSoils(p_rng, soils, n);
+            int ref_counts[CREVASSE + 1] = {0}, test_counts[CREVASSE + 1] = {0};
+            int ref = p_ref->scanSoilRow(soils, n, ref_counts, ref_columns);
+            int test = p_test->scanSoilRow(soils, n, test_counts, test_columns);
+            if (ref != test || memcmp(ref_counts, test_counts, sizeof(ref_counts)) != 0
+                || memcmp(ref_columns, test_columns, ref * sizeof(int)) != 0)
+            {
+                fprintf(stderr, "scanSoilRow : n = %d, %d columns instead of %d, or other counts\n", n, test, ref);
+                nbErrors++;
+            }
+        }
+    }
+    return nbErrors;
+}
+
+int main(void)
+{
+    // the level detected, without any forced level
+    unsetenv("MARC_CPU_LEVEL");
+    t_cpu_level detected = initCpuDispatch();
+    t_kernels ref = bindKernels(CPU_SCALAR);
+    int nbErrors = 0;
+    for (int level = CPU_SSE42; level <= CPU_AVX512; level++)
+    {
+        if (level > (int)detected)
+        {
+            printf("%-7s : not supported by this CPU, skipped\n", getCpuLevelName((t_cpu_level)level));
+            continue;
+        }
+        t_kernels test = bindKernels((t_cpu_level)level);
+        t_rng rng = createRng(2026, (uint64_t)level);
+        int nb = testRowMinFalseCrevasse(&ref, &test, &rng) + testRowMin5(&ref, &test, &rng)
+                 + testDecodeDeltas(&ref, &test, &rng) + testScanSoilRow(&ref, &test, &rng);
+        printf("%-7s : %s\n", getCpuLevelName((t_cpu_level)level), (nb == 0) ? "ok" : "FAILED");
+        nbErrors += nb;
+    }
+    return (nbErrors == 0) ? 0 : 1;
+}
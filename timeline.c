@@ -0,0 +1,142 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <assert.h>
+#include <stdlib.h>
+#include "timeline.h"
+#include "wheel.h"
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to start the next phase of a robot : draws its moves, chooses them and schedules the first one
+ * @param p_config : pointer to the parameters of the missions
+ * @param p_durations : pointer to the durations of the moves
+ * @param p_wheel : pointer to the timing wheel
+ * @param p_robot : pointer to the robot
+ * @param p_record : pointer to the record of the robot
+ * @param robot : the index of the robot
+ * @return none
+ */
+void startTimedPhase(const t_mission_config *, const t_move_durations *, t_timing_wheel *, t_timed_robot *,
+                     t_mission_record *, int);
+
+/* definition of local functions */
+
+void startTimedPhase(const t_mission_config *p_config, const t_move_durations *p_durations, t_timing_wheel *p_wheel,
+                     t_timed_robot *p_robot, t_mission_record *p_record, int robot)
+{
+    t_move draw[PLAN_MAX_MOVES];
+    drawPhaseMoves(p_record->seed, p_record->nbPhases, draw, p_config->nbDraw);
+    p_robot->nbMoves = p_config->strategy(p_config->map, p_robot->loc, draw, p_config->nbDraw, p_config->nbChoose,
+                                          p_robot->moves, p_config->ctx);
+    // without a safe sequence the robot still has to move
+    if (p_robot->nbMoves == 0)
+    {
+        p_robot->moves[0] = draw[0];
+        p_robot->nbMoves = 1;
+    }
+    p_robot->nextMove = 0;
+    p_record->nbPhases++;
+    scheduleEvent(p_wheel, p_wheel->now + p_durations->ticks[p_robot->moves[0]], robot);
+    return;
+}
+
+/* definitions of exported functions */
+
+t_move_durations createDefaultMoveDurations(void)
+{
+    t_move_durations durations;
+    durations.ticks[F_10] = 4;
+    durations.ticks[F_20] = 8;
+    durations.ticks[F_30] = 12;
+    durations.ticks[B_10] = 4;
+    durations.ticks[T_LEFT] = 1;
+    durations.ticks[T_RIGHT] = 1;
+    durations.ticks[U_TURN] = 2;
+    return durations;
+}
+
+t_timeline simulateTimeline(const t_mission_config *p_config, const t_move_durations *p_durations, uint64_t seed_begin,
+                            int nbRobots)
+{
+    assert(nbRobots > 0);
+    t_map map = p_config->map;
+    t_timeline timeline;
+    timeline.nbRobots = nbRobots;
+    timeline.records = (t_mission_record *)malloc(nbRobots * sizeof(t_mission_record));
+    timeline.endTimes = (uint64_t *)calloc(nbRobots, sizeof(uint64_t));
+    timeline.makespan = 0;
+    timeline.nbEvents = 0;
+    t_timed_robot *robots = (t_timed_robot *)malloc(nbRobots * sizeof(t_timed_robot));
+    // a robot has at most one pending event : the end of its move in progress
+    t_timing_wheel wheel = createTimingWheel(nbRobots);
+    for (int r = 0; r < nbRobots; r++)
+    {
+        t_mission_record *p_record = &timeline.records[r];
+        robots[r].loc = drawStartLocalisation(map, seed_begin + r);
+        p_record->seed = seed_begin + r;
+        p_record->start = robots[r].loc;
+        p_record->nbPhases = 0;
+        p_record->outcome = (map.soils[robots[r].loc.pos.y][robots[r].loc.pos.x] == BASE_STATION) ? OUTCOME_BASE
+                                                                                                  : OUTCOME_TIMEOUT;
+        if (p_record->outcome == OUTCOME_TIMEOUT && p_config->maxPhases > 0)
+        {
+            startTimedPhase(p_config, p_durations, &wheel, &robots[r], p_record, r);
+        }
+    }
+    uint64_t time;
+    int r;
+    while (popNextEvent(&wheel, &time, &r))
+    {
+        t_timed_robot *p_robot = &robots[r];
+        t_mission_record *p_record = &timeline.records[r];
+        timeline.nbEvents++;
+        updateLocalisation(&p_robot->loc, p_robot->moves[p_robot->nextMove++]);
+        t_position pos = p_robot->loc.pos;
+        if (!isValidLocalisation(pos, map.x_max, map.y_max))
+        {
+            p_record->outcome = OUTCOME_OUT;
+        }
+        else if (map.soils[pos.y][pos.x] == CREVASSE)
+        {
+            p_record->outcome = OUTCOME_CREVASSE;
+        }
+        else if (map.soils[pos.y][pos.x] == BASE_STATION)
+        {
+            p_record->outcome = OUTCOME_BASE;
+        }
+        else if (p_robot->nextMove < p_robot->nbMoves)
+        {
+            scheduleEvent(&wheel, time + p_durations->ticks[p_robot->moves[p_robot->nextMove]], r);
+            continue;
+        }
+        else if (p_record->nbPhases < p_config->maxPhases)
+        {
+            startTimedPhase(p_config, p_durations, &wheel, p_robot, p_record, r);
+            continue;
+        }
+        // the mission of the robot is over
+        timeline.endTimes[r] = time;
+        timeline.makespan = (time > timeline.makespan) ? time : timeline.makespan;
+    }
+    for (int i = 0; i < nbRobots; i++)
+    {
+        t_position pos = robots[i].loc.pos;
+        timeline.records[i].finalCost = (timeline.records[i].outcome == OUTCOME_OUT) ? COST_UNDEF : map.costs[pos.y][pos.x];
+    }
+    freeTimingWheel(&wheel);
+    free(robots);
+    return timeline;
+}
+
+void freeTimeline(t_timeline *p_timeline)
+{
+    free(p_timeline->records);
+    free(p_timeline->endTimes);
+    p_timeline->records = NULL;
+    p_timeline->endTimes = NULL;
+    return;
+}
@@ -0,0 +1,70 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_TIMELINE_H
+#define UNTITLED1_TIMELINE_H
+
+#include <stdint.h>
+#include "mission.h"
+#include "moves.h"
+#include "results.h"
+
+/**
+ * @brief Structure for the time each kind of move takes, in ticks
+ */
+typedef struct s_move_durations
+{
+    uint32_t    ticks[NB_MOVE_TYPES];   // indexed by t_move
+} t_move_durations;
+
+/**
+ * @brief Structure for the state of a robot of a timeline, between two of its events
+ */
+typedef struct s_timed_robot
+{
+    t_localisation  loc;
+    t_move          moves[PLAN_MAX_MOVES];  // moves chosen for the current phase
+    int             nbMoves;
+    int             nextMove;               // index of the move in progress
+} t_timed_robot;
+
+/**
+ * @brief Structure for the result of a timeline
+ */
+typedef struct s_timeline
+{
+    int                 nbRobots;
+    t_mission_record    *records;   // record of each robot
+    uint64_t            *endTimes;  // time each robot ended its mission
+    uint64_t            makespan;   // time the last robot ended its mission
+    uint64_t            nbEvents;
+} t_timeline;
+
+/**
+ * @brief Function to get durations proportional to the distance covered (turns take a quarter of F_10)
+ * @return the durations
+ */
+t_move_durations createDefaultMoveDurations(void);
+
+/**
+ * @brief Function to simulate robots moving at the same time, each one on its own mission
+ * the end of each move is an event of a timing wheel, applied with updateLocalisation; at the end of the
+ * moves of a phase the robot draws and chooses the moves of the next phase (instantly).
+ * Robot r has the seed seed_begin + r : its record is the one of simulateMission, only times are added.
+ * @param p_config : pointer to the parameters of the missions
+ * @param p_durations : pointer to the durations of the moves
+ * @param seed_begin : the seed of the first robot
+ * @param nbRobots : the number of robots
+ * @return the timeline
+ */
+t_timeline simulateTimeline(const t_mission_config *, const t_move_durations *, uint64_t, int);
+
+/**
+ * @brief Function to free the arrays of a timeline
+ * @param p_timeline : pointer to the timeline
+ * @return none
+ */
+void freeTimeline(t_timeline *);
+
+#endif //UNTITLED1_TIMELINE_H
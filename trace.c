@@ -0,0 +1,547 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "trace.h"
+
+/** layout of a trace file (little endian) :
+ * - header : "MARCTRC1", version (u32), number of maps (u32), number of queries (u64), names offset (u64)
+ * - the queries (t_trace_query), in issue order
+ * - the names of the maps, each ended by '\0', in the order of their indexes
+ */
+#define TRACE_MAGIC "MARCTRC1"
+#define TRACE_VERSION 1
+#define TRACE_HEADER_SIZE 32
+#define TRACE_MAX_MAPS 65536
+
+/**
+ * @brief Delay after which a query counts as started late, in ns
+ */
+#define REPLAY_LATE_NS 1000000LL
+
+/**
+ * @brief Time left before a due time under which a worker spins instead of sleeping, in ns
+ */
+#define REPLAY_SPIN_NS 50000LL
+
+_Static_assert(sizeof(t_trace_query) == 32, "the queries of a trace file are 32 bytes long");
+
+/**
+ * @brief Structure for the state shared by the workers of a replay
+ */
+typedef struct s_replay_shared
+{
+    const t_trace           *trace;
+    const t_replay_target   *targets;
+    double                  speed;
+    uint64_t                first_ns;   // smallest issue time of the trace
+    long long               start_ns;   // clock time the first query is due at
+    atomic_ullong           next;       // next query to run
+} t_replay_shared;
+
+/**
+ * @brief Structure for a worker of a replay, with its own histograms
+ */
+typedef struct s_replay_lane
+{
+    t_replay_shared     *shared;
+    t_latency_histogram latency[NB_QUERY_KINDS];
+    t_latency_histogram service[NB_QUERY_KINDS];
+    uint64_t            nbLate;
+    long long           checksum;
+} t_replay_lane;
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to write a buffer at the end of a trace being written, exiting on error
+ * @param p_writer : pointer to the writer
+ * @param buffer : the buffer
+ * @param size : the size of the buffer
+ * @return none
+ */
+void writeTraceBytes(t_trace_writer *, const void *, size_t);
+
+/**
+ * @brief function to get the index of a map in a trace being written, adding its name on first use
+ * @param p_writer : pointer to the writer
+ * @param name : the name of the map
+ * @return the index of the map
+ */
+int getTraceMapIndex(t_trace_writer *, char *);
+
+/**
+ * @brief function to fill the fields of a query shared by all kinds
+ * @param p_writer : pointer to the writer
+ * @param time_ns : the issue time of the query
+ * @param name : the name of the map queried
+ * @param kind : the kind of the query
+ * @param loc : the localisation queried
+ * @return the query, without draw
+ */
+t_trace_query createTraceQuery(t_trace_writer *, uint64_t, char *, t_query_kind, t_localisation);
+
+/**
+ * @brief function to read the monotonic clock
+ * @return the time in ns
+ */
+long long getReplayClock(void);
+
+/**
+ * @brief function to wait until a time of the monotonic clock, sleeping then spinning for the last few µs
+ * @param time_ns : the time to wait for
+ * @return none
+ */
+void waitReplayClock(long long);
+
+/**
+ * @brief function to run a query against its target
+ * @param p_target : pointer to the target of the map of the query
+ * @param p_query : pointer to the query
+ * @return the result : the cost, the length of the path (-1 if the base station cannot be reached), or the
+ * cost of the best plan (-1 if every plan is fatal)
+ */
+long long runTraceQuery(const t_replay_target *, const t_trace_query *);
+
+/**
+ * @brief function to run the queries of a replay until there are none left (task of the pool)
+ * @param arg : pointer to the t_replay_lane
+ * @return none
+ */
+void runReplayLane(void *);
+
+/* definition of local functions */
+
+void writeTraceBytes(t_trace_writer *p_writer, const void *buffer, size_t size)
+{
+    if (size > 0 && fwrite(buffer, size, 1, p_writer->file) != 1)
+    {
+        fprintf(stderr, "Error: cannot write file %s\n", p_writer->filename);
+        exit(1);
+    }
+    return;
+}
+
+int getTraceMapIndex(t_trace_writer *p_writer, char *name)
+{
+    // traces are mostly runs of queries on the same map
+    if (p_writer->last < p_writer->nbMaps && strcmp(p_writer->names[p_writer->last], name) == 0)
+    {
+        return p_writer->last;
+    }
+    for (int i = 0; i < p_writer->nbMaps; i++)
+    {
+        if (strcmp(p_writer->names[i], name) == 0)
+        {
+            p_writer->last = i;
+            return i;
+        }
+    }
+    if (p_writer->nbMaps == TRACE_MAX_MAPS)
+    {
+        fprintf(stderr, "Error: more than %d maps in the trace %s\n", TRACE_MAX_MAPS, p_writer->filename);
+        exit(1);
+    }
+    if (p_writer->nbMaps == p_writer->capacity)
+    {
+        p_writer->capacity *= 2;
+        p_writer->names = (char **)realloc(p_writer->names, p_writer->capacity * sizeof(char *));
+    }
+    p_writer->names[p_writer->nbMaps] = strdup(name);
+    p_writer->last = p_writer->nbMaps;
+    return p_writer->nbMaps++;
+}
+
+t_trace_query createTraceQuery(t_trace_writer *p_writer, uint64_t time_ns, char *name, t_query_kind kind,
+                               t_localisation loc)
+{
+    t_trace_query query;
+    memset(&query, 0, sizeof(t_trace_query));
+    query.time_ns = time_ns;
+    query.x = loc.pos.x;
+    query.y = loc.pos.y;
+    query.map = (uint16_t)getTraceMapIndex(p_writer, name);
+    query.ori = (uint8_t)loc.ori;
+    query.kind = (uint8_t)kind;
+    return query;
+}
+
+long long getReplayClock(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+void waitReplayClock(long long time_ns)
+{
+    long long now = getReplayClock();
+    if (time_ns - now > REPLAY_SPIN_NS)
+    {
+        // woken up early on purpose : sleeping to the due time would add the wake-up delay to the latencies
+        long long wake = time_ns - REPLAY_SPIN_NS;
+        struct timespec until;
+        until.tv_sec = wake / 1000000000LL;
+        until.tv_nsec = wake % 1000000000LL;
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &until, NULL) != 0)
+        {
+        }
+    }
+    while (getReplayClock() < time_ns)
+    {
+    }
+    return;
+}
+
+long long runTraceQuery(const t_replay_target *p_target, const t_trace_query *p_query)
+{
+    switch (p_query->kind)
+    {
+        case QUERY_COST:
+            return p_target->map.costs[p_query->y][p_query->x];
+        case QUERY_PATH:
+        {
+            int cell = p_query->y * p_target->map.x_max + p_query->x;
+            if (p_target->tree.costs[cell] == COST_UNDEF)
+            {
+                return -1;
+            }
+            long long length = 0;
+            while (p_target->tree.parent[cell] >= 0)
+            {
+                cell = p_target->tree.parent[cell];
+                length++;
+            }
+            return length;
+        }
+        default:
+        {
+            t_localisation loc = loc_init(p_query->x, p_query->y, (t_orientation)p_query->ori);
+            t_move draw[PLAN_MAX_MOVES];
+            for (int i = 0; i < p_query->nbDraw; i++)
+            {
+                draw[i] = (t_move)p_query->draw[i];
+            }
+            t_plan plan;
+            int found = (p_target->coalescer != NULL)
+                        ? coalescedPlanBest(p_target->coalescer, &p_target->planner, 0, loc, draw, p_query->nbDraw,
+                                            p_query->nbChoose, &plan)
+                        : planBest(&p_target->planner, loc, draw, p_query->nbDraw, p_query->nbChoose, &plan);
+            if (!found)
+            {
+                return -1;
+            }
+            return plan.cost;
+        }
+    }
+}
+
+void runReplayLane(void *arg)
+{
+    t_replay_lane *p_lane = (t_replay_lane *)arg;
+    t_replay_shared *p_shared = p_lane->shared;
+    const t_trace *p_trace = p_shared->trace;
+    for (;;)
+    {
+        uint64_t i = atomic_fetch_add(&p_shared->next, 1);
+        if (i >= p_trace->nbQueries)
+        {
+            break;
+        }
+        const t_trace_query *p_query = &p_trace->queries[i];
+        long long due = p_shared->start_ns;
+        if (p_shared->speed > 0.0)
+        {
+            due += (long long)((double)(p_query->time_ns - p_shared->first_ns) / p_shared->speed);
+        }
+        waitReplayClock(due);
+        long long begin = getReplayClock();
+        p_lane->checksum += runTraceQuery(&p_shared->targets[p_query->map], p_query);
+        long long end = getReplayClock();
+        addLatency(&p_lane->latency[p_query->kind], (uint64_t)(end - due));
+        addLatency(&p_lane->service[p_query->kind], (uint64_t)(end - begin));
+        if (begin - due > REPLAY_LATE_NS)
+        {
+            p_lane->nbLate++;
+        }
+    }
+    return;
+}
+
+/* definitions of exported functions */
+
+t_trace_writer createTraceWriter(char *filename)
+{
+    t_trace_writer writer;
+    writer.file = fopen(filename, "wb");
+    if (writer.file == NULL)
+    {
+        fprintf(stderr, "Error: cannot open file %s\n", filename);
+        exit(1);
+    }
+    writer.filename = filename;
+    writer.nbQueries = 0;
+    writer.nbMaps = 0;
+    writer.capacity = 16;
+    writer.last = 0;
+    writer.names = (char **)malloc(writer.capacity * sizeof(char *));
+    // the header is written again on close, once the counts are known
+    char header[TRACE_HEADER_SIZE] = {0};
+    writeTraceBytes(&writer, header, TRACE_HEADER_SIZE);
+    return writer;
+}
+
+void addTraceQuery(t_trace_writer *p_writer, uint64_t time_ns, char *name, t_query_kind kind, t_localisation loc)
+{
+    assert(kind == QUERY_COST || kind == QUERY_PATH);
+    t_trace_query query = createTraceQuery(p_writer, time_ns, name, kind, loc);
+    writeTraceBytes(p_writer, &query, sizeof(t_trace_query));
+    p_writer->nbQueries++;
+    return;
+}
+
+void addTracePlanQuery(t_trace_writer *p_writer, uint64_t time_ns, char *name, t_localisation loc,
+                       const t_move *draw, int nbDraw, int nbChoose)
+{
+    assert(nbDraw > 0 && nbDraw <= PLAN_MAX_MOVES && nbChoose > 0 && nbChoose <= nbDraw);
+    t_trace_query query = createTraceQuery(p_writer, time_ns, name, QUERY_PLAN, loc);
+    query.nbDraw = (uint8_t)nbDraw;
+    query.nbChoose = (uint8_t)nbChoose;
+    for (int i = 0; i < nbDraw; i++)
+    {
+        query.draw[i] = (uint8_t)draw[i];
+    }
+    writeTraceBytes(p_writer, &query, sizeof(t_trace_query));
+    p_writer->nbQueries++;
+    return;
+}
+
+void closeTraceWriter(t_trace_writer *p_writer)
+{
+    uint64_t names = TRACE_HEADER_SIZE + p_writer->nbQueries * sizeof(t_trace_query);
+    for (int i = 0; i < p_writer->nbMaps; i++)
+    {
+        writeTraceBytes(p_writer, p_writer->names[i], strlen(p_writer->names[i]) + 1);
+        free(p_writer->names[i]);
+    }
+    free(p_writer->names);
+    p_writer->names = NULL;
+
+    char header[TRACE_HEADER_SIZE] = {0};
+    uint32_t version = TRACE_VERSION;
+    uint32_t nbMaps = (uint32_t)p_writer->nbMaps;
+    memcpy(header, TRACE_MAGIC, 8);
+    memcpy(header + 8, &version, 4);
+    memcpy(header + 12, &nbMaps, 4);
+    memcpy(header + 16, &p_writer->nbQueries, 8);
+    memcpy(header + 24, &names, 8);
+    if (fseek(p_writer->file, 0, SEEK_SET) != 0 || fwrite(header, TRACE_HEADER_SIZE, 1, p_writer->file) != 1
+        || fclose(p_writer->file) != 0)
+    {
+        fprintf(stderr, "Error: cannot write file %s\n", p_writer->filename);
+        exit(1);
+    }
+    p_writer->file = NULL;
+    return;
+}
+
+t_trace loadTrace(char *filename)
+{
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Error: cannot open file %s\n", filename);
+        exit(1);
+    }
+    char header[TRACE_HEADER_SIZE];
+    uint32_t nbMaps = 0;
+    uint64_t nbQueries = 0, names = 0;
+    long size = -1;
+    if (fread(header, TRACE_HEADER_SIZE, 1, file) == 1 && fseek(file, 0, SEEK_END) == 0)
+    {
+        memcpy(&nbMaps, header + 12, 4);
+        memcpy(&nbQueries, header + 16, 8);
+        memcpy(&names, header + 24, 8);
+        size = ftell(file);
+    }
+    if (size < 0 || memcmp(header, TRACE_MAGIC, 8) != 0 || nbMaps > TRACE_MAX_MAPS
+        || nbQueries > ((uint64_t)size - TRACE_HEADER_SIZE) / sizeof(t_trace_query)
+        || names != TRACE_HEADER_SIZE + nbQueries * sizeof(t_trace_query) || names + nbMaps > (uint64_t)size)
+    {
+        fprintf(stderr, "Error: %s is not a complete trace file\n", filename);
+        exit(1);
+    }
+
+    t_trace trace;
+    trace.nbQueries = nbQueries;
+    trace.nbMaps = (int)nbMaps;
+    trace.queries = (t_trace_query *)malloc(nbQueries * sizeof(t_trace_query) + 1);
+    size_t namesSize = (size_t)size - names;
+    // the names are kept after the array of their pointers, so that one free releases both
+    trace.names = (char **)malloc(nbMaps * sizeof(char *) + namesSize + 1);
+    char *data = (char *)(trace.names + nbMaps);
+    if (fseek(file, TRACE_HEADER_SIZE, SEEK_SET) != 0
+        || (nbQueries > 0 && fread(trace.queries, sizeof(t_trace_query), nbQueries, file) != nbQueries)
+        || (namesSize > 0 && fread(data, namesSize, 1, file) != 1))
+    {
+        fprintf(stderr, "Error: cannot read file %s\n", filename);
+        exit(1);
+    }
+    fclose(file);
+    data[namesSize] = '\0';
+    size_t offset = 0;
+    for (int i = 0; i < trace.nbMaps; i++)
+    {
+        if (offset >= namesSize)
+        {
+            fprintf(stderr, "Error: %s is not a complete trace file\n", filename);
+            exit(1);
+        }
+        trace.names[i] = data + offset;
+        offset += strlen(data + offset) + 1;
+    }
+    for (uint64_t q = 0; q < nbQueries; q++)
+    {
+        t_trace_query query = trace.queries[q];
+        if (query.map >= nbMaps || query.kind >= NB_QUERY_KINDS || query.ori > WEST
+            || (query.kind == QUERY_PLAN && (query.nbDraw == 0 || query.nbDraw > PLAN_MAX_MOVES
+                                             || query.nbChoose == 0 || query.nbChoose > query.nbDraw)))
+        {
+            fprintf(stderr, "Error: invalid query %llu in the trace %s\n", (unsigned long long)q, filename);
+            exit(1);
+        }
+        for (int i = 0; i < query.nbDraw; i++)
+        {
+            if (query.draw[i] > U_TURN)
+            {
+                fprintf(stderr, "Error: invalid query %llu in the trace %s\n", (unsigned long long)q, filename);
+                exit(1);
+            }
+        }
+    }
+    return trace;
+}
+
+void freeTrace(t_trace *p_trace)
+{
+    free(p_trace->queries);
+    free(p_trace->names);
+    p_trace->queries = NULL;
+    p_trace->names = NULL;
+    return;
+}
+
+t_replay_target createReplayTarget(t_map map, int max_reach)
+{
+    t_replay_target target;
+    target.map = map;
+    target.planner = createPlanner(map, max_reach);
+    target.tree = createCostTree(map);
+    target.coalescer = NULL;
+    return target;
+}
+
+void freeReplayTarget(t_replay_target *p_target)
+{
+    freePlanner(&p_target->planner);
+    freeCostTree(&p_target->tree);
+    return;
+}
+
+t_replay_report replayTrace(const t_trace *p_trace, const t_replay_target *targets, t_pool *p_pool, double speed)
+{
+    t_replay_report report;
+    memset(&report, 0, sizeof(t_replay_report));
+    // the queries are checked against their maps before the clock starts
+    uint64_t first = UINT64_MAX, last = 0;
+    for (uint64_t q = 0; q < p_trace->nbQueries; q++)
+    {
+        const t_trace_query *p_query = &p_trace->queries[q];
+        t_position pos;
+        pos.x = p_query->x;
+        pos.y = p_query->y;
+        if (!isValidLocalisation(pos, targets[p_query->map].map.x_max, targets[p_query->map].map.y_max))
+        {
+            fprintf(stderr, "Error: query %llu is out of the map %s\n", (unsigned long long)q,
+                    p_trace->names[p_query->map]);
+            exit(1);
+        }
+        first = (p_query->time_ns < first) ? p_query->time_ns : first;
+        last = (p_query->time_ns > last) ? p_query->time_ns : last;
+    }
+    if (p_trace->nbQueries == 0)
+    {
+        return report;
+    }
+
+    t_replay_shared shared;
+    shared.trace = p_trace;
+    shared.targets = targets;
+    shared.speed = speed;
+    shared.first_ns = first;
+    atomic_init(&shared.next, 0);
+    int nbLanes = p_pool->nbWorkers;
+    t_replay_lane *lanes = (t_replay_lane *)calloc(nbLanes, sizeof(t_replay_lane));
+    t_task_group group;
+    initTaskGroup(&group);
+    // a short delay lets every worker pick its lane before the first query is due
+    shared.start_ns = getReplayClock() + REPLAY_LATE_NS;
+    for (int l = 0; l < nbLanes; l++)
+    {
+        lanes[l].shared = &shared;
+        submitTask(p_pool, &group, runReplayLane, &lanes[l]);
+    }
+    waitTaskGroup(p_pool, &group);
+    destroyTaskGroup(&group);
+    report.elapsed_s = (double)(getReplayClock() - shared.start_ns) / 1e9;
+
+    report.nbQueries = p_trace->nbQueries;
+    report.span_s = (speed > 0.0) ? (double)(last - first) / speed / 1e9 : 0.0;
+    for (int l = 0; l < nbLanes; l++)
+    {
+        for (int k = 0; k < NB_QUERY_KINDS; k++)
+        {
+            mergeLatencyHistogram(&report.latency[k], &lanes[l].latency[k]);
+            mergeLatencyHistogram(&report.service[k], &lanes[l].service[k]);
+        }
+        report.nbLate += lanes[l].nbLate;
+        report.checksum += lanes[l].checksum;
+    }
+    free(lanes);
+    return report;
+}
+
+void printReplayReport(const t_replay_report *p_report, FILE *file)
+{
+    static const char *names[NB_QUERY_KINDS] = {"cost", "path", "plan"};
+    fprintf(file, "%llu queries in %.3f s (trace span %.3f s), %llu started more than 1 ms late, checksum %lld\n",
+            (unsigned long long)p_report->nbQueries, p_report->elapsed_s, p_report->span_s,
+            (unsigned long long)p_report->nbLate, p_report->checksum);
+    t_latency_histogram all;
+    clearLatencyHistogram(&all);
+    fprintf(file, "latency (from the due time)\n");
+    for (int k = 0; k < NB_QUERY_KINDS; k++)
+    {
+        if (p_report->latency[k].nbValues > 0)
+        {
+            printLatencyHistogram(&p_report->latency[k], names[k], file);
+        }
+        mergeLatencyHistogram(&all, &p_report->latency[k]);
+    }
+    printLatencyHistogram(&all, "all", file);
+    fprintf(file, "service time (from the start)\n");
+    for (int k = 0; k < NB_QUERY_KINDS; k++)
+    {
+        if (p_report->service[k].nbValues > 0)
+        {
+            printLatencyHistogram(&p_report->service[k], names[k], file);
+        }
+    }
+    return;
+}
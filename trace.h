@@ -0,0 +1,183 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_TRACE_H
+#define UNTITLED1_TRACE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "coalesce.h"
+#include "critical.h"
+#include "latency.h"
+#include "loc.h"
+#include "planner.h"
+#include "pool.h"
+
+/**
+ * @brief Enum for the kinds of queries of a trace
+ */
+typedef enum e_query_kind
+{
+    QUERY_COST, // cost of a cell
+    QUERY_PATH, // path of a cell to the base station, along the shortest-path tree
+    QUERY_PLAN, // best moves of a draw (planBest)
+    NB_QUERY_KINDS
+} t_query_kind;
+
+/**
+ * @brief Structure for a query of a trace, as stored in the file (32 bytes)
+ */
+typedef struct s_trace_query
+{
+    uint64_t    time_ns;    // issue time since the start of the trace
+    int32_t     x;
+    int32_t     y;
+    uint16_t    map;        // index of the map in the names of the trace
+    uint8_t     ori;
+    uint8_t     kind;
+    uint8_t     nbDraw;     // plan queries only
+    uint8_t     nbChoose;   // plan queries only
+    uint8_t     draw[PLAN_MAX_MOVES];
+    uint8_t     padding;
+} t_trace_query;
+
+/**
+ * @brief Structure for a trace being written
+ */
+typedef struct s_trace_writer
+{
+    FILE        *file;
+    char        *filename;
+    uint64_t    nbQueries;
+    char        **names;    // names of the maps, in order of first use
+    int         nbMaps;
+    int         capacity;
+    int         last;       // index of the map of the last query, tried first
+} t_trace_writer;
+
+/**
+ * @brief Structure for a trace loaded in memory
+ */
+typedef struct s_trace
+{
+    t_trace_query   *queries;   // in issue order
+    uint64_t        nbQueries;
+    char            **names;    // names of the maps, pointing into the same allocation
+    int             nbMaps;
+} t_trace;
+
+/**
+ * @brief Structure for a map queried by a replay, with what its queries need
+ */
+typedef struct s_replay_target
+{
+    t_map       map;
+    t_planner   planner;
+    t_cost_tree tree;
+    t_coalescer *coalescer; // shared by the plan queries of the map, NULL to run each of them
+} t_replay_target;
+
+/**
+ * @brief Structure for the result of a replay
+ * latencies run from the time a query was due (its issue time, scaled) to its end, so a query delayed by
+ * the ones before it counts the wait (no coordinated omission); service times run from its actual start
+ */
+typedef struct s_replay_report
+{
+    t_latency_histogram latency[NB_QUERY_KINDS];
+    t_latency_histogram service[NB_QUERY_KINDS];
+    uint64_t            nbQueries;
+    uint64_t            nbLate;     // queries started more than 1 ms after they were due
+    double              elapsed_s;
+    double              span_s;     // scaled time between the first and the last issue times
+    long long           checksum;   // sum of the results, equal between replays of the same trace
+} t_replay_report;
+
+/**
+ * @brief Function to create a trace file
+ * @param filename : the name of the file
+ * @return the writer
+ */
+t_trace_writer createTraceWriter(char *);
+
+/**
+ * @brief Function to add a cost or path query to a trace
+ * @param p_writer : pointer to the writer
+ * @param time_ns : the issue time of the query since the start of the trace
+ * @param name : the name of the map queried
+ * @param kind : QUERY_COST or QUERY_PATH
+ * @param loc : the localisation queried (its orientation is kept but not used)
+ * @return none
+ */
+void addTraceQuery(t_trace_writer *, uint64_t, char *, t_query_kind, t_localisation);
+
+/**
+ * @brief Function to add a plan query to a trace
+ * @param p_writer : pointer to the writer
+ * @param time_ns : the issue time of the query since the start of the trace
+ * @param name : the name of the map queried
+ * @param loc : the localisation of the robot
+ * @param draw : the moves drawn
+ * @param nbDraw : the number of moves drawn, at most PLAN_MAX_MOVES
+ * @param nbChoose : the number of moves to choose
+ * @return none
+ */
+void addTracePlanQuery(t_trace_writer *, uint64_t, char *, t_localisation, const t_move *, int, int);
+
+/**
+ * @brief Function to write the names of the maps of a trace and close it
+ * @param p_writer : pointer to the writer
+ * @return none
+ */
+void closeTraceWriter(t_trace_writer *);
+
+/**
+ * @brief Function to load a trace file, exiting if it is not a complete trace
+ * @param filename : the name of the file
+ * @return the trace
+ */
+t_trace loadTrace(char *);
+
+/**
+ * @brief Function to free a trace
+ * @param p_trace : pointer to the trace
+ * @return none
+ */
+void freeTrace(t_trace *);
+
+/**
+ * @brief Function to prepare a map for the queries of a replay, without coalescing
+ * @param map : the map, with its costs computed
+ * @param max_reach : the largest translation the planner is built for (see createPlanner)
+ * @return the target
+ */
+t_replay_target createReplayTarget(t_map, int);
+
+/**
+ * @brief Function to free what a replay target built (the map is not freed)
+ * @param p_target : pointer to the target
+ * @return none
+ */
+void freeReplayTarget(t_replay_target *);
+
+/**
+ * @brief Function to replay a trace open-loop : query i is due at its issue time divided by the speed,
+ * whether or not the queries before it are done, and is run by the first free worker of the pool
+ * @param p_trace : pointer to the trace
+ * @param targets : the targets of the maps of the trace, in the order of its names
+ * @param p_pool : pointer to the pool, one query runs per worker at a time
+ * @param speed : the factor applied to the rate of the trace (2 : twice as fast), 0 for all queries due at once
+ * @return the report
+ */
+t_replay_report replayTrace(const t_trace *, const t_replay_target *, t_pool *, double);
+
+/**
+ * @brief Function to print a replay report
+ * @param p_report : pointer to the report
+ * @param file : the file to print to
+ * @return none
+ */
+void printReplayReport(const t_replay_report *, FILE *);
+
+#endif //UNTITLED1_TRACE_H
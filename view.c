@@ -0,0 +1,71 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "view.h"
+
+/* definitions of exported functions */
+
+t_map_view createMapView(t_map map, int x, int y, int width, int height)
+{
+    if (x < 0 || y < 0 || width <= 0 || height <= 0 || x + width > map.x_max || y + height > map.y_max)
+    {
+        fprintf(stderr, "Error: view %dx%d at (%d, %d) is outside the map %dx%d\n", width, height, x, y,
+                map.x_max, map.y_max);
+        exit(1);
+    }
+    t_map_view view;
+    view.origin.x = x;
+    view.origin.y = y;
+    view.map.x_max = width;
+    view.map.y_max = height;
+    view.map.soil_costs = map.soil_costs;
+    view.map.summary.nbBases = -1;
+    // only the row pointers are allocated, shifted to the first column of the window
+    view.map.soils = (t_soil **)malloc(height * sizeof(t_soil *));
+    view.map.costs = (int **)malloc(height * sizeof(int *));
+    for (int i = 0; i < height; i++)
+    {
+        view.map.soils[i] = map.soils[y + i] + x;
+        view.map.costs[i] = (map.costs != NULL) ? map.costs[y + i] + x : NULL;
+    }
+    return view;
+}
+
+t_map_view createSubView(t_map_view view, int x, int y, int width, int height)
+{
+    t_map_view sub = createMapView(view.map, x, y, width, height);
+    sub.origin.x += view.origin.x;
+    sub.origin.y += view.origin.y;
+    return sub;
+}
+
+void freeMapView(t_map_view *p_view)
+{
+    free(p_view->map.soils);
+    free(p_view->map.costs);
+    p_view->map.soils = NULL;
+    p_view->map.costs = NULL;
+    return;
+}
+
+t_position viewToMapPosition(t_map_view view, t_position pos)
+{
+    pos.x += view.origin.x;
+    pos.y += view.origin.y;
+    return pos;
+}
+
+t_position mapToViewPosition(t_map_view view, t_position pos)
+{
+    pos.x -= view.origin.x;
+    pos.y -= view.origin.y;
+    return pos;
+}
+
+int isInMapView(t_map_view view, t_position pos)
+{
+    return isValidLocalisation(mapToViewPosition(view, pos), view.map.x_max, view.map.y_max);
+}
@@ -0,0 +1,75 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_VIEW_H
+#define UNTITLED1_VIEW_H
+
+#include "loc.h"
+#include "map.h"
+
+/**
+ * @brief Structure for a rectangular window of a map, without copy of its soils and costs
+ * the rows of map point into the rows of the parent map, shifted by the origin : the window is a t_map
+ * accepted as is by displayMap, the planner and move simulations
+ */
+typedef struct s_map_view
+{
+    t_map       map;        // the window, of dimensions width x height
+    t_position  origin;     // position in the parent map of the cell (0, 0) of the window
+} t_map_view;
+
+/**
+ * @brief Function to create a view of a rectangle of a map
+ * @param map : the parent map
+ * @param x : the first column of the rectangle
+ * @param y : the first row of the rectangle
+ * @param width : the number of columns
+ * @param height : the number of rows
+ * @return the view
+ */
+t_map_view createMapView(t_map, int, int, int, int);
+
+/**
+ * @brief Function to create a view of a rectangle of a view, with an origin in the map of the parent view
+ * @param view : the parent view
+ * @param x : the first column of the rectangle, in the parent view
+ * @param y : the first row of the rectangle, in the parent view
+ * @param width : the number of columns
+ * @param height : the number of rows
+ * @return the view
+ */
+t_map_view createSubView(t_map_view, int, int, int, int);
+
+/**
+ * @brief Function to free the row arrays of a view (the parent map is not freed)
+ * @param p_view : pointer to the view
+ * @return none
+ */
+void freeMapView(t_map_view *);
+
+/**
+ * @brief Function to convert a position of a view into a position of its parent map
+ * @param view : the view
+ * @param pos : the position in the view
+ * @return the position in the parent map
+ */
+t_position viewToMapPosition(t_map_view, t_position);
+
+/**
+ * @brief Function to convert a position of the parent map into a position of a view
+ * @param view : the view
+ * @param pos : the position in the parent map
+ * @return the position in the view, valid only if the position is inside the view
+ */
+t_position mapToViewPosition(t_map_view, t_position);
+
+/**
+ * @brief Function to check that a position of the parent map is inside a view
+ * @param view : the view
+ * @param pos : the position in the parent map
+ * @return 1 if the position is inside the view, 0 otherwise
+ */
+int isInMapView(t_map_view, t_position);
+
+#endif //UNTITLED1_VIEW_H
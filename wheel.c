@@ -0,0 +1,176 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "wheel.h"
+
+/* prototypes of local functions */
+/* local functions are used only in this file, as helper functions */
+
+/**
+ * @brief function to add a node at the end of the slot of its time
+ * @param p_wheel : pointer to the timing wheel
+ * @param node : the node
+ * @return none
+ */
+void linkWheelNode(t_timing_wheel *, int);
+
+/**
+ * @brief function to find the first occupied slot of a level
+ * @param p_wheel : pointer to the timing wheel
+ * @param level : the level
+ * @return the slot, -1 if the level is empty
+ */
+int getFirstWheelSlot(const t_timing_wheel *, int);
+
+/* definition of local functions */
+
+void linkWheelNode(t_timing_wheel *p_wheel, int node)
+{
+    uint64_t time = p_wheel->times[node];
+    uint64_t diff = time ^ p_wheel->now;
+    int level = (diff == 0) ? 0 : (63 - __builtin_clzll(diff)) / 8;
+    int slot = (int)(time >> (8 * level)) & (WHEEL_SLOTS - 1);
+    int i = level * WHEEL_SLOTS + slot;
+    p_wheel->next[node] = -1;
+    if (p_wheel->heads[i] < 0)
+    {
+        p_wheel->heads[i] = node;
+        p_wheel->occupied[level][slot / 64] |= 1ull << (slot % 64);
+    }
+    else
+    {
+        p_wheel->next[p_wheel->tails[i]] = node;
+    }
+    p_wheel->tails[i] = node;
+    return;
+}
+
+int getFirstWheelSlot(const t_timing_wheel *p_wheel, int level)
+{
+    for (int w = 0; w < WHEEL_SLOTS / 64; w++)
+    {
+        if (p_wheel->occupied[level][w] != 0)
+        {
+            return w * 64 + __builtin_ctzll(p_wheel->occupied[level][w]);
+        }
+    }
+    return -1;
+}
+
+/* definitions of exported functions */
+
+t_timing_wheel createTimingWheel(int capacity)
+{
+    assert(capacity > 0);
+    t_timing_wheel wheel;
+    wheel.now = 0;
+    wheel.heads = (int *)malloc(WHEEL_LEVELS * WHEEL_SLOTS * sizeof(int));
+    wheel.tails = (int *)malloc(WHEEL_LEVELS * WHEEL_SLOTS * sizeof(int));
+    for (int i = 0; i < WHEEL_LEVELS * WHEEL_SLOTS; i++)
+    {
+        wheel.heads[i] = -1;
+    }
+    memset(wheel.occupied, 0, sizeof(wheel.occupied));
+    wheel.times = (uint64_t *)malloc(capacity * sizeof(uint64_t));
+    wheel.values = (int *)malloc(capacity * sizeof(int));
+    wheel.next = (int *)malloc(capacity * sizeof(int));
+    for (int i = 0; i < capacity; i++)
+    {
+        wheel.next[i] = (i < capacity - 1) ? i + 1 : -1;
+    }
+    wheel.free = 0;
+    wheel.capacity = capacity;
+    wheel.nbEvents = 0;
+    return wheel;
+}
+
+void freeTimingWheel(t_timing_wheel *p_wheel)
+{
+    free(p_wheel->heads);
+    free(p_wheel->tails);
+    free(p_wheel->times);
+    free(p_wheel->values);
+    free(p_wheel->next);
+    p_wheel->heads = NULL;
+    p_wheel->tails = NULL;
+    p_wheel->times = NULL;
+    p_wheel->values = NULL;
+    p_wheel->next = NULL;
+    return;
+}
+
+void scheduleEvent(t_timing_wheel *p_wheel, uint64_t time, int value)
+{
+    assert(time >= p_wheel->now);
+    if (p_wheel->free < 0)
+    {
+        int capacity = 2 * p_wheel->capacity;
+        p_wheel->times = (uint64_t *)realloc(p_wheel->times, capacity * sizeof(uint64_t));
+        p_wheel->values = (int *)realloc(p_wheel->values, capacity * sizeof(int));
+        p_wheel->next = (int *)realloc(p_wheel->next, capacity * sizeof(int));
+        for (int i = p_wheel->capacity; i < capacity; i++)
+        {
+            p_wheel->next[i] = (i < capacity - 1) ? i + 1 : -1;
+        }
+        p_wheel->free = p_wheel->capacity;
+        p_wheel->capacity = capacity;
+    }
+    int node = p_wheel->free;
+    p_wheel->free = p_wheel->next[node];
+    p_wheel->times[node] = time;
+    p_wheel->values[node] = value;
+    linkWheelNode(p_wheel, node);
+    p_wheel->nbEvents++;
+    return;
+}
+
+int popNextEvent(t_timing_wheel *p_wheel, uint64_t *p_time, int *p_value)
+{
+    if (p_wheel->nbEvents == 0)
+    {
+        return 0;
+    }
+    // the events of level 0 share all the bits of the current time but the last 8 : the first slot is the earliest
+    int slot = getFirstWheelSlot(p_wheel, 0);
+    while (slot < 0)
+    {
+        int level = 1;
+        while ((slot = getFirstWheelSlot(p_wheel, level)) < 0)
+        {
+            level++;
+            assert(level < WHEEL_LEVELS);
+        }
+        // the clock jumps to the start of the slot, whose events are spread into the lower levels
+        int shift = 8 * level;
+        uint64_t high = (shift + 8 < 64) ? (p_wheel->now >> (shift + 8)) << (shift + 8) : 0;
+        p_wheel->now = high | ((uint64_t)slot << shift);
+        int i = level * WHEEL_SLOTS + slot;
+        int node = p_wheel->heads[i];
+        p_wheel->heads[i] = -1;
+        p_wheel->occupied[level][slot / 64] &= ~(1ull << (slot % 64));
+        while (node >= 0)
+        {
+            int next = p_wheel->next[node];
+            linkWheelNode(p_wheel, node);
+            node = next;
+        }
+        slot = getFirstWheelSlot(p_wheel, 0);
+    }
+    int node = p_wheel->heads[slot];
+    p_wheel->heads[slot] = p_wheel->next[node];
+    if (p_wheel->heads[slot] < 0)
+    {
+        p_wheel->occupied[0][slot / 64] &= ~(1ull << (slot % 64));
+    }
+    p_wheel->now = p_wheel->times[node];
+    *p_time = p_wheel->times[node];
+    *p_value = p_wheel->values[node];
+    p_wheel->next[node] = p_wheel->free;
+    p_wheel->free = node;
+    p_wheel->nbEvents--;
+    return 1;
+}
@@ -0,0 +1,72 @@
+//
+// Created by flasque on 18/10/2026.
+//
+
+#ifndef UNTITLED1_WHEEL_H
+#define UNTITLED1_WHEEL_H
+
+#include <stdint.h>
+
+/**
+ * @brief Number of levels of a timing wheel, each level handles 8 bits of the time
+ */
+#define WHEEL_LEVELS 8
+
+/**
+ * @brief Number of slots of a level of a timing wheel
+ */
+#define WHEEL_SLOTS 256
+
+/**
+ * @brief Structure for a hierarchical timing wheel of events
+ * an event whose time first differs from the current time on the bits of level l is in the slot of level l
+ * given by those bits; when the lower levels are empty, the first slot of the next level is spread into them.
+ * Events are nodes of a pool linked by index, events of the same time come out in the order they were scheduled.
+ */
+typedef struct s_timing_wheel
+{
+    uint64_t    now;                                // time of the last event taken out
+    int         *heads;                             // first node of each slot, -1 for an empty slot
+    int         *tails;                             // last node of each slot
+    uint64_t    occupied[WHEEL_LEVELS][WHEEL_SLOTS / 64];
+    uint64_t    *times;                             // time of each node
+    int         *values;                            // value of each node
+    int         *next;                              // next node in the slot, or in the free list
+    int         free;                               // first free node, -1 if the pool is full
+    int         capacity;
+    int         nbEvents;
+} t_timing_wheel;
+
+/**
+ * @brief Function to create an empty timing wheel, at time 0
+ * @param capacity : the number of events the pool is first allocated for (it grows when needed)
+ * @return the timing wheel
+ */
+t_timing_wheel createTimingWheel(int);
+
+/**
+ * @brief Function to free a timing wheel
+ * @param p_wheel : pointer to the timing wheel
+ * @return none
+ */
+void freeTimingWheel(t_timing_wheel *);
+
+/**
+ * @brief Function to schedule an event
+ * @param p_wheel : pointer to the timing wheel
+ * @param time : the time of the event, not before the current time of the wheel
+ * @param value : the value of the event
+ * @return none
+ */
+void scheduleEvent(t_timing_wheel *, uint64_t, int);
+
+/**
+ * @brief Function to take out the earliest event, the current time of the wheel becomes its time
+ * @param p_wheel : pointer to the timing wheel
+ * @param p_time : pointer receiving the time of the event
+ * @param p_value : pointer receiving the value of the event
+ * @return 1 if an event was taken out, 0 if the wheel is empty
+ */
+int popNextEvent(t_timing_wheel *, uint64_t *, int *);
+
+#endif //UNTITLED1_WHEEL_H